@@ -0,0 +1,171 @@
+// Micro-benchmark of CBezierCurve against the baked binary search it replaced.
+// Configure with -DBUILD_BENCHMARKS=ON and run ./bezier-benchmark from the build dir.
+
+#include "../src/helpers/BezierCurve.hpp"
+#include "../src/debug/Log.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// setup() logs, there is no writer thread here to hand the lines to
+void Debug::pushMessage(LogLevel level, std::string&& msg) {}
+
+void Debug::writeTraceRecord(LogLevel level, const char* fmt, const char* payload, size_t len, uint8_t argc) {}
+
+// the previous implementation: 255 points baked over t, binary searched by x
+class CBakedBezierCurve {
+  public:
+    void setup(const Vector2D& p1, const Vector2D& p2) {
+        m_vP1 = p1;
+        m_vP2 = p2;
+
+        for (int i = 0; i < BAKEDPOINTS; ++i) {
+            m_aPointsBaked[i] = Vector2D(getXForT((i + 1) / (float)BAKEDPOINTS), getYForT((i + 1) / (float)BAKEDPOINTS));
+        }
+    }
+
+    float getYForT(float t) {
+        return 3 * t * pow(1 - t, 2) * m_vP1.y + 3 * pow(t, 2) * (1 - t) * m_vP2.y + pow(t, 3);
+    }
+
+    float getXForT(float t) {
+        return 3 * t * pow(1 - t, 2) * m_vP1.x + 3 * pow(t, 2) * (1 - t) * m_vP2.x + pow(t, 3);
+    }
+
+    float getYForPoint(float x) {
+        if (x >= 1.f)
+            return 1.f;
+
+        int  index = 0;
+        bool below = true;
+        for (int step = (BAKEDPOINTS + 1) / 2; step > 0; step /= 2) {
+            if (below)
+                index += step;
+            else
+                index -= step;
+
+            below = m_aPointsBaked[index].x < x;
+        }
+
+        int        lowerIndex = index - (!below || index == BAKEDPOINTS - 1);
+
+        const auto LOWERPOINT = &m_aPointsBaked[lowerIndex];
+        const auto UPPERPOINT = &m_aPointsBaked[lowerIndex + 1];
+
+        const auto PERCINDELTA = (x - LOWERPOINT->x) / (UPPERPOINT->x - LOWERPOINT->x);
+
+        if (std::isnan(PERCINDELTA) || std::isinf(PERCINDELTA))
+            return 0.f;
+
+        return LOWERPOINT->y + (UPPERPOINT->y - LOWERPOINT->y) * PERCINDELTA;
+    }
+
+  private:
+    static constexpr int              BAKEDPOINTS = 255;
+
+    Vector2D                          m_vP1, m_vP2;
+    std::array<Vector2D, BAKEDPOINTS> m_aPointsBaked;
+};
+
+// y for x by bisecting x(t) in double, the ground truth both are measured against
+static double referenceY(const Vector2D& p1, const Vector2D& p2, double x) {
+    const auto BEZIER = [](double t, double a, double b) { return 3 * t * (1 - t) * (1 - t) * a + 3 * t * t * (1 - t) * b + t * t * t; };
+
+    double     lo = 0, hi = 1;
+    for (int i = 0; i < 64; ++i) {
+        const double MID = (lo + hi) / 2.0;
+        if (BEZIER(MID, p1.x, p2.x) < x)
+            lo = MID;
+        else
+            hi = MID;
+    }
+
+    return BEZIER((lo + hi) / 2.0, p1.y, p2.y);
+}
+
+template <typename F>
+static double nsPerCall(size_t calls, int rounds, const F& fn) {
+    double best = INFINITY;
+
+    // best of a few rounds, the first one also warms the caches up
+    for (int r = 0; r < rounds; ++r) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+        fn();
+        const auto ELAPSED = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - BEGIN).count();
+        best               = std::min(best, ELAPSED / calls);
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv) {
+    struct SCurve {
+        const char* name;
+        Vector2D    p1, p2;
+    };
+
+    const SCurve CURVES[] = {
+        {"default", {0.0, 0.75}, {0.15, 1.0}},
+        {"ease", {0.25, 0.1}, {0.25, 1.0}},
+        {"overshot", {0.05, 0.9}, {0.1, 1.1}},
+        {"linear", {0.5, 0.5}, {0.5, 0.5}},
+    };
+
+    constexpr size_t                      SAMPLES = 1 << 16;
+    constexpr int                         ROUNDS  = 20;
+
+    std::mt19937                          rng(1337);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+
+    std::vector<float>                    xs(SAMPLES), ys(SAMPLES);
+    for (auto& x : xs) {
+        x = dist(rng);
+    }
+
+    volatile float sink = 0;
+
+    printf("%-10s %14s %14s %14s %12s %12s\n", "curve", "baked ns/call", "lut ns/call", "batch ns/val", "baked err", "lut err");
+
+    for (auto& c : CURVES) {
+        CBakedBezierCurve baked;
+        baked.setup(c.p1, c.p2);
+
+        std::vector<Vector2D> points = {c.p1, c.p2};
+        CBezierCurve          curve;
+        curve.setup(&points);
+
+        const double BAKEDNS = nsPerCall(SAMPLES, ROUNDS, [&]() {
+            float acc = 0;
+            for (auto& x : xs) {
+                acc += baked.getYForPoint(x);
+            }
+            sink = acc;
+        });
+
+        const double LUTNS = nsPerCall(SAMPLES, ROUNDS, [&]() {
+            float acc = 0;
+            for (auto& x : xs) {
+                acc += curve.getYForPoint(x);
+            }
+            sink = acc;
+        });
+
+        const double BATCHNS = nsPerCall(SAMPLES, ROUNDS, [&]() {
+            curve.getYForPoints(xs.data(), ys.data(), SAMPLES);
+            sink = ys[SAMPLES / 2];
+        });
+
+        double bakedErr = 0, lutErr = 0;
+        for (size_t i = 0; i < SAMPLES; ++i) {
+            const double REF = referenceY(c.p1, c.p2, xs[i]);
+            bakedErr         = std::max(bakedErr, std::abs(baked.getYForPoint(xs[i]) - REF));
+            lutErr           = std::max({lutErr, std::abs(curve.getYForPoint(xs[i]) - REF), std::abs(ys[i] - REF)});
+        }
+
+        printf("%-10s %14.2f %14.2f %14.2f %12.2e %12.2e\n", c.name, BAKEDNS, LUTNS, BATCHNS, bakedErr, lutErr);
+    }
+
+    return 0;
+}
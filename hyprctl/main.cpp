@@ -50,6 +50,7 @@ commands:
     plugin
     notify
     globalshortcuts
+    stats
     instances
 
 flags:
@@ -394,6 +395,8 @@ int main(int argc, char** argv) {
         request(fullRequest);
     else if (fullRequest.contains("/globalshortcuts"))
         request(fullRequest);
+    else if (fullRequest.contains("/stats"))
+        request(fullRequest);
     else if (fullRequest.contains("/instances"))
         instancesRequest(json);
     else if (fullRequest.contains("/switchxkblayout"))
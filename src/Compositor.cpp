@@ -362,6 +362,7 @@ void CCompositor::cleanup() {
 
     m_vWorkspaces.clear();
     m_vWindows.clear();
+    m_mWorkspacesByID.clear();
 
     for (auto& m : m_vMonitors) {
         g_pHyprOpenGL->destroyMonitorResources(m.get());
@@ -371,6 +372,7 @@ void CCompositor::cleanup() {
     }
 
     m_vMonitors.clear();
+    m_mMonitorsByID.clear();
 
     if (g_pXWaylandManager->m_sWLRXWayland) {
         wlr_xwayland_destroy(g_pXWaylandManager->m_sWLRXWayland);
@@ -534,13 +536,20 @@ void CCompositor::startCompositor() {
 }
 
 CMonitor* CCompositor::getMonitorFromID(const int& id) {
-    for (auto& m : m_vMonitors) {
-        if (m->ID == (uint64_t)id) {
-            return m.get();
-        }
-    }
+    const auto IT     = m_mMonitorsByID.find((uint64_t)id);
+    const auto RESULT = IT == m_mMonitorsByID.end() ? nullptr : IT->second;
 
-    return nullptr;
+#if ISDEBUG
+    const auto LINEAR = std::find_if(m_vMonitors.begin(), m_vMonitors.end(), [&](const auto& m) { return m && m->ID == (uint64_t)id; });
+    RASSERT(RESULT == (LINEAR == m_vMonitors.end() ? nullptr : LINEAR->get()), "Monitor index out of sync for ID {}", id);
+#endif
+
+    return RESULT;
+}
+
+std::string CCompositor::getMonitorNameFromID(const int& id) {
+    const auto PMONITOR = getMonitorFromID(id);
+    return PMONITOR ? PMONITOR->szName : "";
 }
 
 CMonitor* CCompositor::getMonitorFromName(const std::string& name) {
@@ -599,52 +608,60 @@ void CCompositor::removeWindowFromVectorSafe(CWindow* pWindow) {
 }
 
 bool CCompositor::windowExists(CWindow* pWindow) {
-    for (auto& w : m_vWindows) {
-        if (w.get() == pWindow)
-            return true;
-    }
+    const bool RESULT = m_sWindowIndex.contains(pWindow);
 
-    return false;
+#if ISDEBUG
+    const bool LINEAR = std::any_of(m_vWindows.begin(), m_vWindows.end(), [&](const auto& w) { return w && w.get() == pWindow; });
+    RASSERT(RESULT == LINEAR, "Window index out of sync for {:x}", (uintptr_t)pWindow);
+#endif
+
+    return RESULT;
 }
 
 CWindow* CCompositor::vectorToWindow(const Vector2D& pos) {
-    const auto PMONITOR = getMonitorFromVector(pos);
+    const auto  PMONITOR   = getMonitorFromVector(pos);
+    const auto& CANDIDATES = m_sWindowHitIndex.query(pos, pos);
 
     if (PMONITOR->specialWorkspaceID) {
-        for (auto& w : m_vWindows | std::views::reverse) {
-            wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+        for (auto& e : CANDIDATES | std::views::reverse) {
+            const auto w   = e->pWindow;
+            wlr_box    box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
             if (w->m_bIsFloating && w->m_iWorkspaceID == PMONITOR->specialWorkspaceID && w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w->isHidden() &&
                 !w->m_bNoFocus)
-                return w.get();
+                return w;
         }
 
-        for (auto& w : m_vWindows) {
-            wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+        for (auto& e : CANDIDATES) {
+            const auto w   = e->pWindow;
+            wlr_box    box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
             if (w->m_iWorkspaceID == PMONITOR->specialWorkspaceID && wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && !w->m_bIsFloating && !w->isHidden() &&
                 !w->m_bNoFocus)
-                return w.get();
+                return w;
         }
     }
 
     // pinned
-    for (auto& w : m_vWindows | std::views::reverse) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+    for (auto& e : CANDIDATES | std::views::reverse) {
+        const auto w   = e->pWindow;
+        wlr_box    box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
         if (wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && w->m_bIsFloating && !w->isHidden() && w->m_bPinned && !w->m_bNoFocus)
-            return w.get();
+            return w;
     }
 
     // first loop over floating cuz they're above, m_vWindows should be sorted bottom->top, for tiled it doesn't matter.
-    for (auto& w : m_vWindows | std::views::reverse) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+    for (auto& e : CANDIDATES | std::views::reverse) {
+        const auto w   = e->pWindow;
+        wlr_box    box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
         if (wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && w->m_bIsFloating && isWorkspaceVisible(w->m_iWorkspaceID) && !w->isHidden() && !w->m_bPinned &&
             !w->m_bNoFocus)
-            return w.get();
+            return w;
     }
 
-    for (auto& w : m_vWindows) {
-        wlr_box box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
+    for (auto& e : CANDIDATES) {
+        const auto w   = e->pWindow;
+        wlr_box    box = {w->m_vRealPosition.vec().x, w->m_vRealPosition.vec().y, w->m_vRealSize.vec().x, w->m_vRealSize.vec().y};
         if (wlr_box_contains_point(&box, pos.x, pos.y) && w->m_bIsMapped && !w->m_bIsFloating && PMONITOR->activeWorkspace == w->m_iWorkspaceID && !w->isHidden() && !w->m_bNoFocus)
-            return w.get();
+            return w;
     }
 
     return nullptr;
@@ -671,55 +688,53 @@ CWindow* CCompositor::vectorToWindowTiled(const Vector2D& pos) {
 }
 
 CWindow* CCompositor::vectorToWindowIdeal(const Vector2D& pos) {
-    const auto         PMONITOR          = getMonitorFromVector(pos);
-    static auto* const PRESIZEONBORDER   = &g_pConfigManager->getConfigValuePtr("general:resize_on_border")->intValue;
-    static auto* const PBORDERSIZE       = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
-    static auto* const PBORDERGRABEXTEND = &g_pConfigManager->getConfigValuePtr("general:extend_border_grab_area")->intValue;
-    const auto         BORDER_GRAB_AREA  = *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
+    const auto PMONITOR = getMonitorFromVector(pos);
+    const auto CURSOR   = Vector2D{m_sWLRCursor->x, m_sWLRCursor->y};
+
+    // the index caches the input boxes (with the border grab area), pinned and floating windows are tested against the cursor
+    const auto& CANDIDATES = m_sWindowHitIndex.query(pos, CURSOR);
 
     // special workspace
     if (PMONITOR->specialWorkspaceID) {
-        for (auto& w : m_vWindows | std::views::reverse) {
-            const auto BB  = w->getWindowInputBox();
-            wlr_box    box = {BB.x - BORDER_GRAB_AREA, BB.y - BORDER_GRAB_AREA, BB.width + 2 * BORDER_GRAB_AREA, BB.height + 2 * BORDER_GRAB_AREA};
-            if (w->m_bIsFloating && w->m_iWorkspaceID == PMONITOR->specialWorkspaceID && w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w->isHidden() &&
+        for (auto& e : CANDIDATES | std::views::reverse) {
+            const auto w = e->pWindow;
+            if (w->m_bIsFloating && w->m_iWorkspaceID == PMONITOR->specialWorkspaceID && w->m_bIsMapped && wlr_box_contains_point(&e->inputBox, pos.x, pos.y) && !w->isHidden() &&
                 !w->m_bX11ShouldntFocus && !w->m_bNoFocus)
-                return w.get();
+                return w;
         }
 
-        for (auto& w : m_vWindows) {
-            wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+        for (auto& e : CANDIDATES) {
+            const auto w   = e->pWindow;
+            wlr_box    box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
             if (!w->m_bIsFloating && w->m_iWorkspaceID == PMONITOR->specialWorkspaceID && w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && !w->isHidden() &&
                 !w->m_bX11ShouldntFocus && !w->m_bNoFocus)
-                return w.get();
+                return w;
         }
     }
 
     // pinned windows on top of floating regardless
-    for (auto& w : m_vWindows | std::views::reverse) {
-        const auto BB  = w->getWindowInputBox();
-        wlr_box    box = {BB.x - BORDER_GRAB_AREA, BB.y - BORDER_GRAB_AREA, BB.width + 2 * BORDER_GRAB_AREA, BB.height + 2 * BORDER_GRAB_AREA};
+    for (auto& e : CANDIDATES | std::views::reverse) {
+        const auto w = e->pWindow;
         if (w->m_bIsFloating && w->m_bIsMapped && !w->isHidden() && !w->m_bX11ShouldntFocus && w->m_bPinned && !w->m_bNoFocus) {
-            if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y))
-                return w.get();
+            if (wlr_box_contains_point(&e->inputBox, CURSOR.x, CURSOR.y))
+                return w;
 
             if (!w->m_bIsX11) {
                 if (w->hasPopupAt(pos))
-                    return w.get();
+                    return w;
             }
         }
     }
 
     // first loop over floating cuz they're above, m_lWindows should be sorted bottom->top, for tiled it doesn't matter.
-    for (auto& w : m_vWindows | std::views::reverse) {
-        const auto BB  = w->getWindowInputBox();
-        wlr_box    box = {BB.x - BORDER_GRAB_AREA, BB.y - BORDER_GRAB_AREA, BB.width + 2 * BORDER_GRAB_AREA, BB.height + 2 * BORDER_GRAB_AREA};
+    for (auto& e : CANDIDATES | std::views::reverse) {
+        const auto w = e->pWindow;
         if (w->m_bIsFloating && w->m_bIsMapped && isWorkspaceVisible(w->m_iWorkspaceID) && !w->isHidden() && !w->m_bPinned && !w->m_bNoFocus) {
             // OR windows should add focus to parent
             if (w->m_bX11ShouldntFocus && w->m_iX11Type != 2)
                 continue;
 
-            if (wlr_box_contains_point(&box, m_sWLRCursor->x, m_sWLRCursor->y)) {
+            if (wlr_box_contains_point(&e->inputBox, CURSOR.x, CURSOR.y)) {
 
                 if (w->m_bIsX11 && w->m_iX11Type == 2 && !wlr_xwayland_or_surface_wants_focus(w->m_uSurface.xwayland)) {
                     // Override Redirect
@@ -727,28 +742,30 @@ CWindow* CCompositor::vectorToWindowIdeal(const Vector2D& pos) {
                                                          // TODO: this is wrong, we should focus the parent, but idk how to get it considering it's nullptr in most cases.
                 }
 
-                return w.get();
+                return w;
             }
 
             if (!w->m_bIsX11) {
                 if (w->hasPopupAt(pos))
-                    return w.get();
+                    return w;
             }
         }
     }
 
     // for windows, we need to check their extensions too, first.
-    for (auto& w : m_vWindows) {
+    for (auto& e : CANDIDATES) {
+        const auto w = e->pWindow;
         if (!w->m_bIsX11 && !w->m_bIsFloating && w->m_bIsMapped && w->m_iWorkspaceID == PMONITOR->activeWorkspace && !w->isHidden() && !w->m_bX11ShouldntFocus && !w->m_bNoFocus) {
-            if ((w)->hasPopupAt(pos))
-                return w.get();
+            if (w->hasPopupAt(pos))
+                return w;
         }
     }
-    for (auto& w : m_vWindows) {
-        wlr_box box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
+    for (auto& e : CANDIDATES) {
+        const auto w   = e->pWindow;
+        wlr_box    box = {w->m_vPosition.x, w->m_vPosition.y, w->m_vSize.x, w->m_vSize.y};
         if (!w->m_bIsFloating && w->m_bIsMapped && wlr_box_contains_point(&box, pos.x, pos.y) && w->m_iWorkspaceID == PMONITOR->activeWorkspace && !w->isHidden() &&
             !w->m_bX11ShouldntFocus && !w->m_bNoFocus)
-            return w.get();
+            return w;
     }
 
     return nullptr;
@@ -974,8 +991,9 @@ void CCompositor::focusWindow(CWindow* pWindow, wlr_surface* pSurface) {
         pWindow->m_bIsUrgent = false;
 
     // Send an event
-    g_pEventManager->postEvent(SHyprIPCEvent{"activewindow", g_pXWaylandManager->getAppIDClass(pWindow) + "," + pWindow->m_szTitle});
-    g_pEventManager->postEvent(SHyprIPCEvent{"activewindowv2", std::format("{:x}", (uintptr_t)pWindow)});
+    const auto MONITORNAME = getMonitorNameFromID(pWindow->m_iMonitorID);
+    g_pEventManager->postEvent(SHyprIPCEvent{"activewindow", g_pXWaylandManager->getAppIDClass(pWindow) + "," + pWindow->m_szTitle, MONITORNAME});
+    g_pEventManager->postEvent(SHyprIPCEvent{"activewindowv2", std::format("{:x}", (uintptr_t)pWindow), MONITORNAME});
 
     EMIT_HOOK_EVENT("activeWindow", pWindow);
 
@@ -1116,25 +1134,27 @@ wlr_surface* CCompositor::vectorToLayerSurface(const Vector2D& pos, std::vector<
 }
 
 CWindow* CCompositor::getWindowFromSurface(wlr_surface* pSurface) {
-    for (auto& w : m_vWindows) {
-        if (!w->m_bIsMapped || w->m_bFadingOut || !w->m_bMappedX11)
-            continue;
+    CWindow* result = nullptr;
 
-        if (w->m_pWLSurface.wlr() == pSurface)
-            return w.get();
+    // the entry can outlive the surface (destroyed while mapped), so the hit has to be checked.
+    if (const auto IT = m_mWindowsBySurface.find(pSurface); IT != m_mWindowsBySurface.end()) {
+        const auto PWINDOW = IT->second;
+        if (PWINDOW->m_bIsMapped && !PWINDOW->m_bFadingOut && PWINDOW->m_bMappedX11 && PWINDOW->m_pWLSurface.wlr() == pSurface)
+            result = PWINDOW;
     }
 
-    return nullptr;
+#if ISDEBUG
+    const auto LINEAR = std::find_if(m_vWindows.begin(), m_vWindows.end(),
+                                     [&](const auto& w) { return w && w->m_bIsMapped && !w->m_bFadingOut && w->m_bMappedX11 && w->m_pWLSurface.wlr() == pSurface; });
+    RASSERT(result == (LINEAR == m_vWindows.end() ? nullptr : LINEAR->get()), "Window surface index out of sync for {:x}", (uintptr_t)pSurface);
+#endif
+
+    return result;
 }
 
 CWindow* CCompositor::getWindowFromHandle(uint32_t handle) {
-    for (auto& w : m_vWindows) {
-        if ((uint32_t)(((uint64_t)w.get()) & 0xFFFFFFFF) == handle) {
-            return w.get();
-        }
-    }
-
-    return nullptr;
+    const auto IT = m_mWindowsByHandle.find(handle);
+    return IT == m_mWindowsByHandle.end() ? nullptr : IT->second;
 }
 
 CWindow* CCompositor::getWindowFromZWLRHandle(wl_resource* handle) {
@@ -1176,12 +1196,15 @@ bool CCompositor::isWorkspaceVisible(const int& w) {
 }
 
 CWorkspace* CCompositor::getWorkspaceByID(const int& id) {
-    for (auto& w : m_vWorkspaces) {
-        if (w->m_iID == id)
-            return w.get();
-    }
+    const auto IT     = m_mWorkspacesByID.find(id);
+    const auto RESULT = IT == m_mWorkspacesByID.end() ? nullptr : IT->second;
 
-    return nullptr;
+#if ISDEBUG
+    const auto LINEAR = std::find_if(m_vWorkspaces.begin(), m_vWorkspaces.end(), [&](const auto& w) { return w && w->m_iID == id; });
+    RASSERT(RESULT == (LINEAR == m_vWorkspaces.end() ? nullptr : LINEAR->get()), "Workspace index out of sync for ID {}", id);
+#endif
+
+    return RESULT;
 }
 
 void CCompositor::sanityCheckWorkspaces() {
@@ -1326,6 +1349,8 @@ void CCompositor::changeWindowZOrder(CWindow* pWindow, bool top) {
             }
         }
 
+        m_sWindowHitIndex.invalidate();
+
         if (pw->m_bIsMapped)
             g_pHyprRenderer->damageMonitor(getMonitorFromID(pw->m_iMonitorID));
     };
@@ -1375,6 +1400,7 @@ void CCompositor::cleanupFadingOut(const int& monid) {
                 continue;
 
             std::erase_if(g_pHyprOpenGL->m_mWindowFramebuffers, [&](const auto& other) { return other.first == w; });
+            std::erase_if(g_pHyprOpenGL->m_mWindowBlurCaches, [&](const auto& other) { return other.first == w; });
             w->m_bFadingOut = false;
             removeWindowFromVectorSafe(w);
             std::erase(m_vWindowsFadingOut, w);
@@ -1727,6 +1753,8 @@ CMonitor* CCompositor::getMonitorInDirection(const char& dir) {
 }
 
 void CCompositor::updateAllWindowsAnimatedDecorationValues() {
+    m_sWindowHitIndex.invalidate();
+
     for (auto& w : m_vWindows) {
         if (!w->m_bIsMapped)
             continue;
@@ -1823,6 +1851,9 @@ void CCompositor::updateWindowAnimatedDecorationValues(CWindow* pWindow) {
 
     for (auto& d : pWindow->m_dWindowDecorations)
         d->updateWindow(pWindow);
+
+    // the border gradient is swapped without animating, the rest is caught by the animation tick once it moves
+    g_pProtocolManager->m_pToplevelExportProtocolManager->invalidateWindow(pWindow);
 }
 
 int CCompositor::getNextAvailableMonitorID(std::string const& name) {
@@ -1911,9 +1942,9 @@ void CCompositor::swapActiveWorkspaces(CMonitor* pMonitorA, CMonitor* pMonitorB)
     g_pInputManager->simulateMouseMovement();
 
     // event
-    g_pEventManager->postEvent(SHyprIPCEvent{"moveworkspace", PWORKSPACEA->m_szName + "," + pMonitorB->szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"moveworkspace", PWORKSPACEA->m_szName + "," + pMonitorB->szName, pMonitorB->szName});
     EMIT_HOOK_EVENT("moveWorkspace", (std::vector<void*>{PWORKSPACEA, pMonitorB}));
-    g_pEventManager->postEvent(SHyprIPCEvent{"moveworkspace", PWORKSPACEB->m_szName + "," + pMonitorA->szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"moveworkspace", PWORKSPACEB->m_szName + "," + pMonitorA->szName, pMonitorA->szName});
     EMIT_HOOK_EVENT("moveWorkspace", (std::vector<void*>{PWORKSPACEB, pMonitorA}));
 }
 
@@ -2105,7 +2136,7 @@ void CCompositor::moveWorkspaceToMonitor(CWorkspace* pWorkspace, CMonitor* pMoni
     updateFullscreenFadeOnWorkspace(pWorkspace);
 
     // event
-    g_pEventManager->postEvent(SHyprIPCEvent{"moveworkspace", pWorkspace->m_szName + "," + pMonitor->szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"moveworkspace", pWorkspace->m_szName + "," + pMonitor->szName, pMonitor->szName});
     EMIT_HOOK_EVENT("moveWorkspace", (std::vector<void*>{pWorkspace, pMonitor}));
 }
 
@@ -2444,6 +2475,8 @@ CWorkspace* CCompositor::createNewWorkspace(const int& id, const int& monid, con
     PWORKSPACE->m_iID        = id;
     PWORKSPACE->m_iMonitorID = monID;
 
+    indexWorkspace(PWORKSPACE);
+
     return PWORKSPACE;
 }
 
@@ -2459,7 +2492,7 @@ void CCompositor::renameWorkspace(const int& id, const std::string& name) {
     Debug::log(LOG, "renameWorkspace: Renaming workspace {} to '{}'", id, name);
     PWORKSPACE->m_szName = name;
 
-    g_pEventManager->postEvent({"renameworkspace", std::to_string(PWORKSPACE->m_iID) + "," + PWORKSPACE->m_szName});
+    g_pEventManager->postEvent({"renameworkspace", std::to_string(PWORKSPACE->m_iID) + "," + PWORKSPACE->m_szName, getMonitorNameFromID(PWORKSPACE->m_iMonitorID)});
 }
 
 void CCompositor::setActiveMonitor(CMonitor* pMonitor) {
@@ -2473,7 +2506,7 @@ void CCompositor::setActiveMonitor(CMonitor* pMonitor) {
 
     const auto PWORKSPACE = getWorkspaceByID(pMonitor->activeWorkspace);
 
-    g_pEventManager->postEvent(SHyprIPCEvent{"focusedmon", pMonitor->szName + "," + PWORKSPACE->m_szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"focusedmon", pMonitor->szName + "," + PWORKSPACE->m_szName, pMonitor->szName});
     EMIT_HOOK_EVENT("focusedMon", pMonitor);
     m_pLastMonitor = pMonitor;
 }
@@ -2577,6 +2610,8 @@ void CCompositor::arrangeMonitors() {
     static auto* const     PXWLFORCESCALEZERO = &g_pConfigManager->getConfigValuePtr("xwayland:force_zero_scaling")->intValue;
 
     std::vector<CMonitor*> toArrange;
+
+    m_sWindowHitIndex.invalidate();
     std::vector<CMonitor*> arranged;
 
     for (auto& m : m_vMonitors)
@@ -2671,3 +2706,47 @@ void CCompositor::leaveUnsafeState() {
 
     m_pUnsafeOutput = nullptr;
 }
+
+void CCompositor::indexWindow(CWindow* pWindow) {
+    m_sWindowHitIndex.invalidate();
+    m_sWindowIndex.insert(pWindow);
+    m_mWindowsByHandle[(uint32_t)(((uint64_t)pWindow) & 0xFFFFFFFF)] = pWindow;
+}
+
+void CCompositor::unindexWindow(CWindow* pWindow) {
+    m_sWindowHitIndex.invalidate();
+    unindexWindowSurface(pWindow);
+    m_sWindowIndex.erase(pWindow);
+    if (const auto IT = m_mWindowsByHandle.find((uint32_t)(((uint64_t)pWindow) & 0xFFFFFFFF)); IT != m_mWindowsByHandle.end() && IT->second == pWindow)
+        m_mWindowsByHandle.erase(IT);
+}
+
+void CCompositor::indexWindowSurface(CWindow* pWindow) {
+    m_sWindowHitIndex.invalidate();
+
+    if (pWindow->m_pWLSurface.wlr())
+        m_mWindowsBySurface[pWindow->m_pWLSurface.wlr()] = pWindow;
+}
+
+void CCompositor::unindexWindowSurface(CWindow* pWindow) {
+    m_sWindowHitIndex.invalidate();
+    std::erase_if(m_mWindowsBySurface, [&](const auto& other) { return other.second == pWindow; });
+}
+
+void CCompositor::indexWorkspace(CWorkspace* pWorkspace) {
+    m_mWorkspacesByID[pWorkspace->m_iID] = pWorkspace;
+}
+
+void CCompositor::unindexWorkspace(CWorkspace* pWorkspace) {
+    if (const auto IT = m_mWorkspacesByID.find(pWorkspace->m_iID); IT != m_mWorkspacesByID.end() && IT->second == pWorkspace)
+        m_mWorkspacesByID.erase(IT);
+}
+
+void CCompositor::indexMonitor(CMonitor* pMonitor) {
+    m_mMonitorsByID[pMonitor->ID] = pMonitor;
+}
+
+void CCompositor::unindexMonitor(CMonitor* pMonitor) {
+    if (const auto IT = m_mMonitorsByID.find(pMonitor->ID); IT != m_mMonitorsByID.end() && IT->second == pMonitor)
+        m_mMonitorsByID.erase(IT);
+}
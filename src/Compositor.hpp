@@ -3,6 +3,8 @@
 #include <memory>
 #include <deque>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "defines.hpp"
 #include "debug/Log.hpp"
@@ -22,6 +24,7 @@
 #include "debug/HyprNotificationOverlay.hpp"
 #include "helpers/Monitor.hpp"
 #include "helpers/Workspace.hpp"
+#include "helpers/WindowHitIndex.hpp"
 #include "Window.hpp"
 #include "render/Renderer.hpp"
 #include "render/OpenGL.hpp"
@@ -104,6 +107,17 @@ class CCompositor {
 
     std::unordered_map<std::string, uint64_t> m_mMonitorIDMap;
 
+    // O(1) lookup indexes for the vectors above. Kept in sync by the index* / unindex* methods below,
+    // lookups re-check the hit and debug builds verify them against a linear scan.
+    std::unordered_set<CWindow*>               m_sWindowIndex;
+    std::unordered_map<uint32_t, CWindow*>     m_mWindowsByHandle;
+    std::unordered_map<wlr_surface*, CWindow*> m_mWindowsBySurface;
+    std::unordered_map<int, CWorkspace*>       m_mWorkspacesByID;
+    std::unordered_map<uint64_t, CMonitor*>    m_mMonitorsByID;
+
+    // pointer hit-testing grid for vectorToWindow / vectorToWindowIdeal, invalidated on window geometry / stacking changes
+    CWindowHitIndex                            m_sWindowHitIndex;
+
     void                                      initServer();
     void                                      startCompositor();
     void                                      cleanup();
@@ -132,6 +146,7 @@ class CCompositor {
     CMonitor*      getMonitorFromDesc(const std::string&);
     CMonitor*      getMonitorFromCursor();
     CMonitor*      getMonitorFromVector(const Vector2D&);
+    std::string    getMonitorNameFromID(const int&); // empty if there is none, for SHyprIPCEvent::monitor
     void           removeWindowFromVectorSafe(CWindow*);
     void           focusWindow(CWindow*, wlr_surface* pSurface = nullptr);
     void           focusSurface(wlr_surface*, CWindow* pWindowOwner = nullptr);
@@ -207,6 +222,14 @@ class CCompositor {
     void           arrangeMonitors();
     void           enterUnsafeState();
     void           leaveUnsafeState();
+    void           indexWindow(CWindow*);
+    void           unindexWindow(CWindow*);
+    void           indexWindowSurface(CWindow*);
+    void           unindexWindowSurface(CWindow*);
+    void           indexWorkspace(CWorkspace*);
+    void           unindexWorkspace(CWorkspace*);
+    void           indexMonitor(CMonitor*);
+    void           unindexMonitor(CMonitor*);
 
     std::string    explicitConfigPath;
 
@@ -14,9 +14,13 @@ CWindow::CWindow() {
     m_fDimPercent.create(AVARTYPE_FLOAT, g_pConfigManager->getAnimationPropertyConfig("fadeDim"), (void*)this, AVARDAMAGE_ENTIRE);
 
     m_dWindowDecorations.emplace_back(std::make_unique<CHyprDropShadowDecoration>(this)); // put the shadow so it's the first deco (has to be rendered first)
+
+    g_pCompositor->indexWindow(this);
 }
 
 CWindow::~CWindow() {
+    g_pCompositor->unindexWindow(this);
+
     if (g_pCompositor->isWindowActive(this)) {
         g_pCompositor->m_pLastFocus  = nullptr;
         g_pCompositor->m_pLastWindow = nullptr;
@@ -208,6 +212,12 @@ void CWindow::updateWindowDecos() {
         g_pLayoutManager->getCurrentLayout()->recalculateWindow(this);
 
     m_vDecosToRemove.clear();
+
+    // input extents may have changed
+    g_pCompositor->m_sWindowHitIndex.invalidate();
+
+    // and so may have what the decorations draw
+    g_pProtocolManager->m_pToplevelExportProtocolManager->invalidateWindow(this);
 }
 
 pid_t CWindow::getPID() {
@@ -341,7 +351,8 @@ void CWindow::moveToWorkspace(int workspaceID) {
     updateSpecialRenderData();
 
     if (PWORKSPACE) {
-        g_pEventManager->postEvent(SHyprIPCEvent{"movewindow", std::format("{:x},{}", (uintptr_t)this, PWORKSPACE->m_szName)});
+        g_pEventManager->postEvent(
+            SHyprIPCEvent{"movewindow", std::format("{:x},{}", (uintptr_t)this, PWORKSPACE->m_szName), g_pCompositor->getMonitorNameFromID(PWORKSPACE->m_iMonitorID)});
         EMIT_HOOK_EVENT("moveWindow", (std::vector<void*>{this, PWORKSPACE}));
     }
 
@@ -405,6 +416,7 @@ void CWindow::onUnmap() {
 
     std::erase_if(g_pCompositor->m_vWindowFocusHistory, [&](const auto& other) { return other == this; });
 
+    g_pCompositor->unindexWindowSurface(this);
     m_pWLSurface.unassign();
 
     hyprListener_unmapWindow.removeCallback();
@@ -424,6 +436,7 @@ void CWindow::onUnmap() {
 void CWindow::onMap() {
 
     m_pWLSurface.assign(g_pXWaylandManager->getWindowSurface(this));
+    g_pCompositor->indexWindowSurface(this);
 
     // JIC, reset the callbacks. If any are set, we'll make sure they are cleared so we don't accidentally unset them. (In case a window got remapped)
     m_vRealPosition.resetAllCallbacks();
@@ -589,6 +602,8 @@ void CWindow::updateDynamicRules() {
     m_sAdditionalConfigData.xray            = -1;
     m_sAdditionalConfigData.forceTearing    = false;
 
+    g_pCompositor->m_sWindowHitIndex.invalidate(); // dimaround / bordersize change the input box
+
     const auto WINDOWRULES = g_pConfigManager->getMatchingRules(this);
     for (auto& r : WINDOWRULES) {
         applyDynamicRule(r);
@@ -5,6 +5,7 @@
 #include "helpers/AnimatedVariable.hpp"
 #include "render/decorations/IHyprWindowDecoration.hpp"
 #include <deque>
+#include <regex>
 #include "config/ConfigDataValues.hpp"
 #include "helpers/Vector2D.hpp"
 #include "helpers/WLSurface.hpp"
@@ -155,6 +156,24 @@ struct SWindowRule {
     int         bFullscreen = -1;
     int         bPinned     = -1;
     std::string szWorkspace = ""; // empty means any
+
+    // compiled once when the rule is added, never at match time
+    std::shared_ptr<std::regex> rClass;
+    std::shared_ptr<std::regex> rTitle;
+};
+
+// everything getMatchingRules() looks at. If none of it changed, neither did the result.
+struct SWindowRuleMatchKey {
+    std::string appidclass;
+    std::string title;
+    std::string workspaceName;
+    int         workspaceID = -1;
+    bool        x11         = false;
+    bool        floating    = false;
+    bool        fullscreen  = false;
+    bool        pinned      = false;
+
+    bool        operator==(const SWindowRuleMatchKey&) const = default;
 };
 
 class CWindow {
@@ -322,6 +341,11 @@ class CWindow {
 
     bool     m_bTearingHint = false;
 
+    // cached CConfigManager::getMatchingRules() result
+    uint64_t                 m_iMatchedRulesGeneration = 0;
+    SWindowRuleMatchKey      m_sMatchedRulesKey;
+    std::vector<SWindowRule> m_vMatchedRules;
+
     // For the list lookup
     bool operator==(const CWindow& rhs) {
         return m_uSurface.xdg == rhs.m_uSurface.xdg && m_uSurface.xwayland == rhs.m_uSurface.xwayland && m_vPosition == rhs.m_vPosition && m_vSize == rhs.m_vSize &&
@@ -31,6 +31,8 @@ CConfigManager::CConfigManager() {
 
     Debug::disableLogs = &configValues["debug:disable_logs"].intValue;
     Debug::disableTime = &configValues["debug:disable_time"].intValue;
+    Debug::minLogLevel = &configValues["debug:log_level"].intValue;
+    Debug::binaryTrace = &configValues["debug:binary_trace"].intValue;
 
     populateEnvironment();
 }
@@ -124,6 +126,13 @@ void CConfigManager::setDefaultVars() {
     configValues["misc:groupbar_text_color"].intValue              = 0xffffffff;
     configValues["misc:background_color"].intValue                 = 0xff111111;
     configValues["misc:new_window_takes_over_fullscreen"].intValue = 0;
+    configValues["misc:socket2_queue_size"].intValue               = 1024;
+    configValues["misc:socket2_overflow_policy"].intValue          = 0;
+    configValues["misc:occlusion_culling"].intValue                = 1;
+    // caps for EVERY toplevel export, meant for taskbar / switcher thumbnails. They also downscale and throttle window sharing
+    // through xdg-desktop-portal-hyprland, leave them at 0 (off) when sharing windows at full size and rate.
+    configValues["misc:toplevel_export_max_size"].intValue = 0;
+    configValues["misc:toplevel_export_max_fps"].intValue  = 0;
 
     configValues["debug:int"].intValue                = 0;
     configValues["debug:log_damage"].intValue         = 0;
@@ -136,6 +145,9 @@ void CConfigManager::setDefaultVars() {
     configValues["debug:manual_crash"].intValue       = 0;
     configValues["debug:suppress_errors"].intValue    = 0;
     configValues["debug:watchdog_timeout"].intValue   = 5;
+    configValues["debug:log_level"].intValue          = 0;
+    configValues["debug:binary_trace"].intValue       = 0;
+    configValues["debug:gpu_timing"].intValue         = 0;
 
     configValues["decoration:rounding"].intValue               = 0;
     configValues["decoration:blur:enabled"].intValue           = 1;
@@ -148,6 +160,8 @@ void CConfigManager::setDefaultVars() {
     configValues["decoration:blur:contrast"].floatValue        = 0.8916;
     configValues["decoration:blur:brightness"].floatValue      = 0.8172;
     configValues["decoration:blur:special"].intValue           = 0;
+    configValues["decoration:blur:window_cache"].intValue      = 1;
+    configValues["decoration:blur:downsample"].intValue        = 0;
     configValues["decoration:active_opacity"].floatValue       = 1;
     configValues["decoration:inactive_opacity"].floatValue     = 1;
     configValues["decoration:fullscreen_opacity"].floatValue   = 1;
@@ -212,6 +226,8 @@ void CConfigManager::setDefaultVars() {
     configValues["input:scroll_method"].strValue                    = STRVAL_EMPTY;
     configValues["input:scroll_button"].intValue                    = 0;
     configValues["input:scroll_button_lock"].intValue               = 0;
+    configValues["input:motion_coalescing"].intValue                = 0;
+    configValues["input:motion_coalescing_rate"].intValue           = 0;
     configValues["input:touchpad:natural_scroll"].intValue          = 0;
     configValues["input:touchpad:disable_while_typing"].intValue    = 1;
     configValues["input:touchpad:clickfinger_behavior"].intValue    = 0;
@@ -933,6 +949,7 @@ void CConfigManager::handleWindowRule(const std::string& command, const std::str
 
     if (RULE == "unset") {
         std::erase_if(m_dWindowRules, [&](const SWindowRule& other) { return other.szValue == VALUE; });
+        onWindowRulesChanged();
         return;
     }
 
@@ -943,10 +960,17 @@ void CConfigManager::handleWindowRule(const std::string& command, const std::str
         return;
     }
 
+    SWindowRule rule{RULE, VALUE};
+
+    if (!compileWindowRule(rule))
+        return;
+
     if (RULE.find("size") == 0 || RULE.find("maxsize") == 0 || RULE.find("minsize") == 0)
-        m_dWindowRules.push_front({RULE, VALUE});
+        m_dWindowRules.push_front(rule);
     else
-        m_dWindowRules.push_back({RULE, VALUE});
+        m_dWindowRules.push_back(rule);
+
+    onWindowRulesChanged();
 }
 
 void CConfigManager::handleLayerRule(const std::string& command, const std::string& value) {
@@ -1087,13 +1111,19 @@ void CConfigManager::handleWindowRuleV2(const std::string& command, const std::s
                 return true;
             }
         });
+        onWindowRulesChanged();
         return;
     }
 
+    if (!compileWindowRule(rule))
+        return;
+
     if (RULE.find("size") == 0 || RULE.find("maxsize") == 0 || RULE.find("minsize") == 0)
         m_dWindowRules.push_front(rule);
     else
         m_dWindowRules.push_back(rule);
+
+    onWindowRulesChanged();
 }
 
 void CConfigManager::updateBlurredLS(const std::string& name, const bool forceBlur) {
@@ -1378,6 +1408,10 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
             }
         }
 
+        // variables resolve their curve once, pick up the new one
+        if (COMMAND == "animation" || COMMAND == "bezier")
+            g_pAnimationManager->refreshBeziers();
+
         // Update window border colors
         g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
@@ -1505,6 +1539,7 @@ void CConfigManager::loadConfigLoadVars() {
     setDefaultVars();
     m_dMonitorRules.clear();
     m_dWindowRules.clear();
+    onWindowRulesChanged();
     g_pKeybindManager->clearKeybinds();
     g_pAnimationManager->removeAllBeziers();
     m_mAdditionalReservedAreas.clear();
@@ -1593,6 +1628,9 @@ void CConfigManager::loadConfigLoadVars() {
         ifs.close();
     }
 
+    // removeAllBeziers above freed the curves the variables resolved
+    g_pAnimationManager->refreshBeziers();
+
     for (auto& m : g_pCompositor->m_vMonitors)
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->ID);
 
@@ -1836,100 +1874,114 @@ SWorkspaceRule CConfigManager::getWorkspaceRuleFor(CWorkspace* pWorkspace) {
     return *IT;
 }
 
-std::vector<SWindowRule> CConfigManager::getMatchingRules(CWindow* pWindow) {
-    if (!g_pCompositor->windowValidMapped(pWindow))
-        return std::vector<SWindowRule>();
+bool CConfigManager::compileWindowRule(SWindowRule& rule) {
+    try {
+        if (!rule.v2) {
+            if (rule.szValue.find("title:") == 0)
+                rule.rTitle = std::make_shared<std::regex>(rule.szValue.substr(6));
+            else
+                rule.rClass = std::make_shared<std::regex>(rule.szValue);
+        } else {
+            if (!rule.szClass.empty())
+                rule.rClass = std::make_shared<std::regex>(rule.szClass);
 
-    std::vector<SWindowRule> returns;
+            if (!rule.szTitle.empty())
+                rule.rTitle = std::make_shared<std::regex>(rule.szTitle);
+        }
+    } catch (std::exception& e) {
+        Debug::log(ERR, "Regex error at {} ({})", rule.szValue, e.what());
+        parseError = "Invalid regex in windowrule " + rule.szValue + ": " + e.what();
+        return false;
+    }
 
-    std::string              title      = g_pXWaylandManager->getTitle(pWindow);
-    std::string              appidclass = g_pXWaylandManager->getAppIDClass(pWindow);
+    return true;
+}
 
-    Debug::log(LOG, "Searching for matching rules for {} (title: {})", appidclass, title);
+void CConfigManager::onWindowRulesChanged() {
+    m_iWindowRulesGeneration++;
+    m_mWindowRulesByClass.clear();
+}
 
-    // since some rules will be applied later, we need to store some flags
-    bool hasFloating   = pWindow->m_bIsFloating;
-    bool hasFullscreen = pWindow->m_bIsFullscreen;
+const std::vector<size_t>& CConfigManager::getWindowRulesForClass(const std::string& appidclass) {
+    if (const auto IT = m_mWindowRulesByClass.find(appidclass); IT != m_mWindowRulesByClass.end())
+        return IT->second;
 
-    for (auto& rule : m_dWindowRules) {
-        // check if we have a matching rule
-        if (!rule.v2) {
-            try {
-                if (rule.szValue.find("title:") == 0) {
-                    // we have a title rule.
-                    std::regex RULECHECK(rule.szValue.substr(6));
+    // the class part of a rule only depends on the class, so it's evaluated once per class per rule set
+    auto& indices = m_mWindowRulesByClass[appidclass];
 
-                    if (!std::regex_search(title, RULECHECK))
-                        continue;
-                } else {
-                    std::regex classCheck(rule.szValue);
+    for (size_t i = 0; i < m_dWindowRules.size(); ++i) {
+        const auto& RULE = m_dWindowRules[i];
 
-                    if (!std::regex_search(appidclass, classCheck))
-                        continue;
-                }
-            } catch (...) {
-                Debug::log(ERR, "Regex error at {}", rule.szValue);
-                continue;
-            }
-        } else {
-            try {
-                if (rule.szClass != "") {
-                    std::regex RULECHECK(rule.szClass);
+        if (RULE.rClass && !std::regex_search(appidclass, *RULE.rClass))
+            continue;
 
-                    if (!std::regex_search(appidclass, RULECHECK))
-                        continue;
-                }
+        indices.push_back(i);
+    }
 
-                if (rule.szTitle != "") {
-                    std::regex RULECHECK(rule.szTitle);
+    return indices;
+}
 
-                    if (!std::regex_search(title, RULECHECK))
-                        continue;
-                }
+std::vector<SWindowRule> CConfigManager::matchWindowRules(CWindow* pWindow, const SWindowRuleMatchKey& key) {
+    std::vector<SWindowRule> returns;
 
-                if (rule.bX11 != -1) {
-                    if (pWindow->m_bIsX11 != rule.bX11)
-                        continue;
-                }
+    Debug::log(LOG, "Searching for matching rules for {} (title: {})", key.appidclass, key.title);
 
-                if (rule.bFloating != -1) {
-                    if (hasFloating != rule.bFloating)
-                        continue;
-                }
+    // since some rules will be applied later, we need to store some flags
+    bool hasFloating   = key.floating;
+    bool hasFullscreen = key.fullscreen;
 
-                if (rule.bFullscreen != -1) {
-                    if (hasFullscreen != rule.bFullscreen)
-                        continue;
-                }
+    for (const auto& IDX : getWindowRulesForClass(key.appidclass)) {
+        const auto& rule = m_dWindowRules[IDX];
 
-                if (rule.bPinned != -1) {
-                    if (pWindow->m_bPinned != rule.bPinned)
-                        continue;
-                }
+        // the class already matched, check the rest
+        if (rule.rTitle && !std::regex_search(key.title, *rule.rTitle))
+            continue;
 
-                if (!rule.szWorkspace.empty()) {
-                    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pWindow->m_iWorkspaceID);
+        if (rule.v2) {
+            if (rule.bX11 != -1) {
+                if (key.x11 != rule.bX11)
+                    continue;
+            }
 
-                    if (!PWORKSPACE)
-                        continue;
+            if (rule.bFloating != -1) {
+                if (hasFloating != rule.bFloating)
+                    continue;
+            }
 
-                    if (rule.szWorkspace.find("name:") == 0) {
-                        if (PWORKSPACE->m_szName != rule.szWorkspace.substr(5))
-                            continue;
-                    } else {
-                        // number
-                        if (!isNumber(rule.szWorkspace))
-                            throw std::runtime_error("szWorkspace not name: or number");
+            if (rule.bFullscreen != -1) {
+                if (hasFullscreen != rule.bFullscreen)
+                    continue;
+            }
 
-                        const int64_t ID = std::stoll(rule.szWorkspace);
+            if (rule.bPinned != -1) {
+                if (key.pinned != rule.bPinned)
+                    continue;
+            }
+
+            if (!rule.szWorkspace.empty()) {
+                const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(key.workspaceID);
+
+                if (!PWORKSPACE)
+                    continue;
+
+                if (rule.szWorkspace.find("name:") == 0) {
+                    if (PWORKSPACE->m_szName != rule.szWorkspace.substr(5))
+                        continue;
+                } else {
+                    // number
+                    if (!isNumber(rule.szWorkspace)) {
+                        Debug::log(ERR, "Invalid workspace in {}", rule.szValue);
+                        continue;
+                    }
 
-                        if (PWORKSPACE->m_iID != ID)
+                    try {
+                        if (PWORKSPACE->m_iID != std::stoll(rule.szWorkspace))
                             continue;
+                    } catch (std::exception& e) {
+                        Debug::log(ERR, "Invalid workspace in {} ({})", rule.szValue, e.what());
+                        continue;
                     }
                 }
-            } catch (std::exception& e) {
-                Debug::log(ERR, "Regex error at {} ({})", rule.szValue, e.what());
-                continue;
             }
         }
 
@@ -1944,6 +1996,39 @@ std::vector<SWindowRule> CConfigManager::getMatchingRules(CWindow* pWindow) {
             hasFullscreen = true;
     }
 
+    return returns;
+}
+
+std::vector<SWindowRule> CConfigManager::getMatchingRules(CWindow* pWindow) {
+    if (!g_pCompositor->windowValidMapped(pWindow))
+        return std::vector<SWindowRule>();
+
+    const auto          PWORKSPACE = g_pCompositor->getWorkspaceByID(pWindow->m_iWorkspaceID);
+
+    SWindowRuleMatchKey key = {
+        .appidclass    = g_pXWaylandManager->getAppIDClass(pWindow),
+        .title         = g_pXWaylandManager->getTitle(pWindow),
+        .workspaceName = PWORKSPACE ? PWORKSPACE->m_szName : "",
+        .workspaceID   = pWindow->m_iWorkspaceID,
+        .x11           = pWindow->m_bIsX11,
+        .floating      = pWindow->m_bIsFloating,
+        .fullscreen    = pWindow->m_bIsFullscreen,
+        .pinned        = pWindow->m_bPinned,
+    };
+
+    // only re-match if the rules or anything the rules look at changed
+    if (pWindow->m_iMatchedRulesGeneration != m_iWindowRulesGeneration || pWindow->m_sMatchedRulesKey != key) {
+        pWindow->m_vMatchedRules           = matchWindowRules(pWindow, key);
+        pWindow->m_sMatchedRulesKey        = std::move(key);
+        pWindow->m_iMatchedRulesGeneration = m_iWindowRulesGeneration;
+    }
+
+    std::vector<SWindowRule> returns = pWindow->m_vMatchedRules;
+
+    // exec rules are one-shot and keyed on the pid, so they are never cached. Don't walk /proc if there are none.
+    if (execRequestedRules.empty())
+        return returns;
+
     std::vector<uint64_t> PIDs = {(uint64_t)pWindow->getPID()};
     while (getPPIDof(PIDs.back()) > 10)
         PIDs.push_back(getPPIDof(PIDs.back()));
@@ -167,6 +167,13 @@ class CConfigManager {
     std::deque<SMonitorRule>                                                                   m_dMonitorRules;
     std::deque<SWorkspaceRule>                                                                 m_dWorkspaceRules;
     std::deque<SWindowRule>                                                                    m_dWindowRules;
+    uint64_t                                                                                   m_iWindowRulesGeneration = 1; // bumped on every change to m_dWindowRules
+    std::unordered_map<std::string, std::vector<size_t>>                                       m_mWindowRulesByClass; // class -> indices of rules whose class part matches
+
+    bool                                                                                       compileWindowRule(SWindowRule&);
+    void                                                                                       onWindowRulesChanged();
+    const std::vector<size_t>&                                                                 getWindowRulesForClass(const std::string&);
+    std::vector<SWindowRule>                                                                   matchWindowRules(CWindow*, const SWindowRuleMatchKey&);
     std::deque<SLayerRule>                                                                     m_dLayerRules;
     std::deque<std::string>                                                                    m_dBlurLSNamespaces;
 
@@ -586,6 +586,142 @@ std::string globalShortcutsRequest(HyprCtl::eHyprCtlOutputFormat format) {
     return ret;
 }
 
+std::string statsRequest(HyprCtl::eHyprCtlOutputFormat format) {
+    std::string ret         = "";
+    const auto  EVENTSTATS  = g_pEventManager->getStats();
+    const auto  MOTIONSTATS = g_pInputManager->getMotionCoalescingStats();
+    const auto  DAMAGESTATS = g_pHyprRenderer->getDamageBatchStats();
+    const auto  CULLSTATS   = g_pHyprRenderer->getOcclusionStats();
+    const auto  BLURSTATS   = g_pHyprOpenGL->getBlurStats();
+    const auto  GPUSTATS    = g_pHyprOpenGL->m_tGPUTimer.getStats();
+    if (format == HyprCtl::eHyprCtlOutputFormat::FORMAT_NORMAL) {
+        ret += std::format("socket2:\n\tclients: {}\n\tqueued events: {}\n\tmax queue depth: {}\n\tposted events: {}\n\tdropped events: {}\n\toverflow disconnects: {}\n",
+                           EVENTSTATS.clients, EVENTSTATS.queuedEvents, EVENTSTATS.maxQueueDepth, EVENTSTATS.postedEvents, EVENTSTATS.droppedEvents, EVENTSTATS.disconnects);
+        ret += std::format("pointer motion:\n\treceived: {}\n\tprocessed: {}\n\tcoalesced: {}\n", MOTIONSTATS.received, MOTIONSTATS.processed, MOTIONSTATS.coalesced);
+        ret += std::format("damage batching:\n\tbatches: {}\n\trects in: {}\n\trects out: {}\n", DAMAGESTATS.batches, DAMAGESTATS.rectsIn, DAMAGESTATS.rectsOut);
+        ret += std::format("occlusion culling:\n\tculled draws: {}\n\tculled pixels: {}\n", CULLSTATS.culledDraws, CULLSTATS.culledPixels);
+        ret += std::format("blur:\n\tpasses: {}\n\tpixels: {}\n\tcache hits: {}\n\tcache misses: {}\n\tcached pixels: {}\n", BLURSTATS.passes, BLURSTATS.pixels,
+                           BLURSTATS.cacheHits, BLURSTATS.cacheMisses, BLURSTATS.cachedPixels);
+        ret += std::format("gpu timing:\n\tsupported: {}\n\tcollected frames: {}\n\tdiscarded frames: {}\n\tdropped frames: {}\n", g_pHyprOpenGL->m_tGPUTimer.supported(),
+                           GPUSTATS.collectedFrames, GPUSTATS.discardedFrames, GPUSTATS.droppedFrames);
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            const auto TIMES = g_pHyprOpenGL->m_tGPUTimer.getFrameTimes(m.get());
+            ret += std::format("\t{}:\n\t\tframes: {}\n\t\ttotal: {:.3f}ms\n\t\tmax: {:.3f}ms\n", m->szName, TIMES.frames, TIMES.total, TIMES.max);
+            for (size_t i = 0; i < GPU_STAGE_COUNT; ++i) {
+                ret += std::format("\t\t{}: {:.3f}ms\n", GPUSTAGENAMES[i], TIMES.stages[i]);
+            }
+        }
+        ret += "screencopy:\n";
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            const auto CAPTURES = g_pProtocolManager->m_pScreencopyProtocolManager->getCaptureStats(m.get());
+            ret += std::format("\t{}:\n\t\tshared captures: {}\n\t\tunique captures: {}\n", m->szName, CAPTURES.sharedCaptures, CAPTURES.uniqueCaptures);
+        }
+    } else {
+        ret += "{";
+        ret += std::format(R"#(
+    "socket2": {{
+        "clients": {},
+        "queuedEvents": {},
+        "maxQueueDepth": {},
+        "postedEvents": {},
+        "droppedEvents": {},
+        "overflowDisconnects": {}
+    }},)#",
+                           EVENTSTATS.clients, EVENTSTATS.queuedEvents, EVENTSTATS.maxQueueDepth, EVENTSTATS.postedEvents, EVENTSTATS.droppedEvents, EVENTSTATS.disconnects);
+        ret += std::format(R"#(
+    "pointerMotion": {{
+        "received": {},
+        "processed": {},
+        "coalesced": {}
+    }},)#",
+                           MOTIONSTATS.received, MOTIONSTATS.processed, MOTIONSTATS.coalesced);
+        ret += std::format(R"#(
+    "damageBatching": {{
+        "batches": {},
+        "rectsIn": {},
+        "rectsOut": {}
+    }},)#",
+                           DAMAGESTATS.batches, DAMAGESTATS.rectsIn, DAMAGESTATS.rectsOut);
+        ret += std::format(R"#(
+    "occlusionCulling": {{
+        "culledDraws": {},
+        "culledPixels": {}
+    }},)#",
+                           CULLSTATS.culledDraws, CULLSTATS.culledPixels);
+        ret += std::format(R"#(
+    "blur": {{
+        "passes": {},
+        "pixels": {},
+        "cacheHits": {},
+        "cacheMisses": {},
+        "cachedPixels": {}
+    }},)#",
+                           BLURSTATS.passes, BLURSTATS.pixels, BLURSTATS.cacheHits, BLURSTATS.cacheMisses, BLURSTATS.cachedPixels);
+
+        std::string gpuMonitors = "";
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            const auto  TIMES = g_pHyprOpenGL->m_tGPUTimer.getFrameTimes(m.get());
+
+            std::string stages = "";
+            for (size_t i = 0; i < GPU_STAGE_COUNT; ++i) {
+                stages += std::format(R"#(
+                "{}": {:.3f},)#",
+                                      GPUSTAGENAMES[i], TIMES.stages[i]);
+            }
+            trimTrailingComma(stages);
+
+            gpuMonitors += std::format(R"#(
+        {{
+            "name": "{}",
+            "frames": {},
+            "total": {:.3f},
+            "max": {:.3f},
+            "stages": {{{}
+            }}
+        }},)#",
+                                       escapeJSONStrings(m->szName), TIMES.frames, TIMES.total, TIMES.max, stages);
+        }
+        trimTrailingComma(gpuMonitors);
+
+        ret += std::format(R"#(
+    "gpuTiming": {{
+        "supported": {},
+        "collectedFrames": {},
+        "discardedFrames": {},
+        "droppedFrames": {},
+        "monitors": [{}
+        ]
+    }},)#",
+                           g_pHyprOpenGL->m_tGPUTimer.supported(), GPUSTATS.collectedFrames, GPUSTATS.discardedFrames, GPUSTATS.droppedFrames, gpuMonitors);
+
+        std::string captureMonitors = "";
+        for (auto& m : g_pCompositor->m_vMonitors) {
+            const auto CAPTURES = g_pProtocolManager->m_pScreencopyProtocolManager->getCaptureStats(m.get());
+
+            captureMonitors += std::format(R"#(
+        {{
+            "name": "{}",
+            "sharedCaptures": {},
+            "uniqueCaptures": {}
+        }},)#",
+                                           escapeJSONStrings(m->szName), CAPTURES.sharedCaptures, CAPTURES.uniqueCaptures);
+        }
+        trimTrailingComma(captureMonitors);
+
+        ret += std::format(R"#(
+    "screencopy": {{
+        "monitors": [{}
+        ]
+    }},)#",
+                           captureMonitors);
+
+        trimTrailingComma(ret);
+        ret += "\n}\n";
+    }
+
+    return ret;
+}
+
 std::string bindsRequest(HyprCtl::eHyprCtlOutputFormat format) {
     std::string ret = "";
     if (format == HyprCtl::eHyprCtlOutputFormat::FORMAT_NORMAL) {
@@ -1285,6 +1421,8 @@ std::string getReply(std::string request) {
         return globalShortcutsRequest(format);
     else if (request == "animations")
         return animationsRequest(format);
+    else if (request == "stats")
+        return statsRequest(format);
     else if (request.find("plugin") == 0)
         return dispatchPlugin(request);
     else if (request.find("notify") == 0)
@@ -1315,33 +1453,28 @@ std::string HyprCtl::makeDynamicCall(const std::string& input) {
     return getReply(input);
 }
 
-int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
-    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
-        return 0;
+struct SHyprCtlClient {
+    int              fd     = -1;
+    wl_event_source* source = nullptr;
 
-    sockaddr_in clientAddress;
-    socklen_t   clientSize = sizeof(clientAddress);
+    std::string      inBuffer;
+    std::string      outBuffer;
 
-    const auto  ACCEPTEDCONNECTION = accept4(HyprCtl::iSocketFD, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC);
+    bool             persistent      = false;
+    bool             closeAfterFlush = false;
 
-    char        readBuffer[1024];
+    uint32_t         eventMask = WL_EVENT_READABLE;
+};
 
-    fd_set      fdset;
-    FD_ZERO(&fdset);
-    FD_SET(ACCEPTEDCONNECTION, &fdset);
-    timeval timeout = {.tv_sec = 0, .tv_usec = 5000};
-    auto    success = select(ACCEPTEDCONNECTION + 1, &fdset, nullptr, nullptr, &timeout);
+static std::list<SHyprCtlClient> clients;
 
-    if (success <= 0) {
-        close(ACCEPTEDCONNECTION);
-        return 0;
-    }
-
-    auto messageSize                                     = read(ACCEPTEDCONNECTION, readBuffer, 1024);
-    readBuffer[messageSize == 1024 ? 1023 : messageSize] = '\0';
-
-    std::string request(readBuffer);
+static void removeClient(SHyprCtlClient* client) {
+    wl_event_source_remove(client->source);
+    close(client->fd);
+    std::erase_if(clients, [&](const auto& other) { return &other == client; });
+}
 
+static std::string dispatchSafe(const std::string& request) {
     std::string reply = "";
 
     try {
@@ -1351,14 +1484,181 @@ int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
         reply = "Err: " + std::string(e.what());
     }
 
-    write(ACCEPTEDCONNECTION, reply.c_str(), reply.length());
+    if (g_pConfigManager->m_bWantsMonitorReload)
+        g_pConfigManager->ensureMonitorStatus();
 
-    close(ACCEPTEDCONNECTION);
+    return reply;
+}
 
-    if (g_pConfigManager->m_bWantsMonitorReload) {
-        g_pConfigManager->ensureMonitorStatus();
+// returns false if the client is gone
+static bool flushClient(SHyprCtlClient* client) {
+    while (!client->outBuffer.empty()) {
+        const auto WRITTEN = write(client->fd, client->outBuffer.data(), client->outBuffer.size());
+
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            removeClient(client);
+            return false;
+        }
+
+        client->outBuffer.erase(0, WRITTEN);
+    }
+
+    if (client->outBuffer.empty() && client->closeAfterFlush) {
+        removeClient(client);
+        return false;
+    }
+
+    // only poll for writability while there is something left to send, and stop reading once we are just draining
+    // or the client isn't reading its replies
+    const bool     READ    = !client->closeAfterFlush && client->outBuffer.size() < HyprCtl::MAX_PENDING_REPLIES;
+    const uint32_t NEWMASK = (READ ? WL_EVENT_READABLE : 0) | (client->outBuffer.empty() ? 0 : WL_EVENT_WRITABLE);
+    if (NEWMASK != client->eventMask) {
+        client->eventMask = NEWMASK;
+        wl_event_source_fd_update(client->source, NEWMASK);
+    }
+
+    return true;
+}
+
+static void processPersistentRequests(SHyprCtlClient* client) {
+    size_t offset = 0;
+
+    // the rest waits in inBuffer until the client reads what it has been sent
+    while (client->inBuffer.size() - offset >= sizeof(uint32_t) && client->outBuffer.size() < HyprCtl::MAX_PENDING_REPLIES) {
+        uint32_t length = 0;
+        memcpy(&length, client->inBuffer.data() + offset, sizeof(uint32_t));
+
+        if (length > HyprCtl::MAX_FRAME_LENGTH) {
+            Debug::log(ERR, "hyprctl client at fd {} sent an oversized frame ({} bytes), dropping", client->fd, length);
+            client->inBuffer.clear();
+            client->closeAfterFlush = true;
+            return;
+        }
+
+        if (client->inBuffer.size() - offset - sizeof(uint32_t) < length)
+            break; // incomplete, wait for more
+
+        const auto     REPLY  = dispatchSafe(client->inBuffer.substr(offset + sizeof(uint32_t), length));
+        const uint32_t REPLEN = REPLY.length();
+
+        client->outBuffer.append((const char*)&REPLEN, sizeof(uint32_t));
+        client->outBuffer.append(REPLY);
+
+        offset += sizeof(uint32_t) + length;
+    }
+
+    client->inBuffer.erase(0, offset);
+}
+
+int hyprCtlClientTick(int fd, uint32_t mask, void* data) {
+    const auto CLIENT = (SHyprCtlClient*)data;
+
+    // on a hangup with data pending the peer might have half-closed after sending, read what's there first
+    if ((mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) && !(mask & WL_EVENT_READABLE)) {
+        removeClient(CLIENT);
+        return 0;
+    }
+
+    if (mask & WL_EVENT_WRITABLE) {
+        if (!flushClient(CLIENT))
+            return 0;
+
+        // requests held back while the replies were piling up
+        if (CLIENT->persistent && !CLIENT->inBuffer.empty() && CLIENT->outBuffer.size() < HyprCtl::MAX_PENDING_REPLIES) {
+            processPersistentRequests(CLIENT);
+            if (!flushClient(CLIENT))
+                return 0;
+        }
+    }
+
+    if (!(mask & WL_EVENT_READABLE))
+        return 0;
+
+    char readBuffer[4096];
+    bool peerClosed = false;
+
+    while (true) {
+        const auto RECEIVED = read(fd, readBuffer, sizeof(readBuffer));
+
+        if (RECEIVED < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                peerClosed = true;
+
+            break;
+        }
+
+        if (RECEIVED == 0) {
+            peerClosed = true;
+            break;
+        }
+
+        CLIENT->inBuffer.append(readBuffer, RECEIVED);
+
+        // legacy requests are a single message, persistent ones get at most a frame buffered per tick.
+        // Don't let a misbehaving client grow us forever, the rest stays in the socket for the next tick.
+        if (CLIENT->inBuffer.size() > HyprCtl::MAX_FRAME_LENGTH + sizeof(uint32_t))
+            break;
     }
 
+    if (!CLIENT->persistent && !CLIENT->closeAfterFlush) {
+        const auto& MAGIC = HyprCtl::PERSISTENT_MAGIC;
+
+        if (CLIENT->inBuffer.starts_with(MAGIC)) {
+            CLIENT->persistent = true;
+            CLIENT->inBuffer.erase(0, MAGIC.length());
+        } else if (CLIENT->inBuffer.length() < MAGIC.length() && MAGIC.starts_with(CLIENT->inBuffer) && !peerClosed) {
+            return 0; // could still become a persistent client, wait for the rest of the magic
+        } else if (!CLIENT->inBuffer.empty()) {
+            // legacy one-shot request: one message in, one reply out, then close.
+            CLIENT->outBuffer       = dispatchSafe(CLIENT->inBuffer);
+            CLIENT->closeAfterFlush = true;
+            CLIENT->inBuffer.clear();
+        }
+    }
+
+    if (CLIENT->persistent)
+        processPersistentRequests(CLIENT);
+
+    if (peerClosed) {
+        if (CLIENT->outBuffer.empty()) {
+            removeClient(CLIENT);
+            return 0;
+        }
+
+        CLIENT->closeAfterFlush = true;
+    }
+
+    flushClient(CLIENT);
+
+    return 0;
+}
+
+int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
+        return 0;
+
+    sockaddr_in clientAddress;
+    socklen_t   clientSize = sizeof(clientAddress);
+
+    const auto  ACCEPTEDCONNECTION = accept4(HyprCtl::iSocketFD, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+    if (ACCEPTEDCONNECTION < 0)
+        return 0;
+
+    // the reply is sent from the client's own event source, so we never block the loop waiting on a client
+    auto& client  = clients.emplace_back();
+    client.fd     = ACCEPTEDCONNECTION;
+    client.source = wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, ACCEPTEDCONNECTION, WL_EVENT_READABLE, hyprCtlClientTick, &client);
+
     return 0;
 }
 
@@ -19,6 +19,14 @@ namespace HyprCtl {
 
     inline int              iSocketFD = -1;
 
+    // persistent mode: a client that opens with PERSISTENT_MAGIC keeps the connection open
+    // and sends requests as [uint32 length][payload] frames, replies are framed the same way
+    // and come back in request order. Anything else is handled as a one-shot legacy request.
+    inline const std::string  PERSISTENT_MAGIC = "HYPRIPC\x01";
+    inline constexpr uint32_t MAX_FRAME_LENGTH = 16 * 1024 * 1024;
+    // replies a persistent client hasn't read yet. Past this we stop reading and dispatching its requests until it catches up.
+    inline constexpr size_t MAX_PENDING_REPLIES = 16 * 1024 * 1024;
+
     enum eHyprCtlOutputFormat {
         FORMAT_NORMAL = 0,
         FORMAT_JSON
@@ -173,6 +173,29 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     if (cairoExtents.width > maxX)
         maxX = cairoExtents.width;
 
+    // gpu times come back a few frames late and only with GL_EXT_disjoint_timer_query
+    const auto GPUTIMES = g_pHyprOpenGL->m_tGPUTimer.getFrameTimes(m_pMonitor);
+    if (GPUTIMES.frames > 0) {
+        yOffset += 11;
+        cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+        text = std::format("Avg GPU Rendertime: {:.2f}ms (max {:.2f}ms)", GPUTIMES.total, GPUTIMES.max);
+        cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+        cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+        if (cairoExtents.width > maxX)
+            maxX = cairoExtents.width;
+
+        yOffset += 11;
+        cairo_move_to(g_pDebugOverlay->m_pCairo, 0, yOffset);
+        text = "GPU:";
+        for (size_t i = 0; i < GPU_STAGE_COUNT; ++i) {
+            text += std::format(" {} {:.2f}ms", GPUSTAGENAMES[i], GPUTIMES.stages[i]);
+        }
+        cairo_show_text(g_pDebugOverlay->m_pCairo, text.c_str());
+        cairo_text_extents(g_pDebugOverlay->m_pCairo, text.c_str(), &cairoExtents);
+        if (cairoExtents.width > maxX)
+            maxX = cairoExtents.width;
+    }
+
     yOffset += 11;
 
     g_pHyprRenderer->damageBox(&m_wbLastDrawnBox);
@@ -4,26 +4,244 @@
 
 #include <fstream>
 #include <iostream>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <time.h>
+
+// Multi-producer single-consumer intrusive queue (Vyukov). Producers only do one atomic exchange,
+// the consumer side is serialized by consumerMutex, which is only ever taken by the writer or a flush.
+struct SLogNode {
+    std::atomic<SLogNode*> next = nullptr;
+    std::string            msg;
+    bool                   toStdout = false;
+};
+
+static SLogNode               stubNode;
+static std::atomic<SLogNode*> queueHead = &stubNode;
+static SLogNode*              queueTail = &stubNode;
+
+static std::mutex             consumerMutex;
+static std::atomic<uint32_t>  queueSeq     = 0;
+static std::atomic<bool>      writerStop   = false;
+static std::atomic<bool>      writerActive = false;
+static std::thread            writerThread;
+static int                    logFD = -1;
+
+static bool popMessage(std::string& out, bool& toStdout) {
+    SLogNode*  tail = queueTail;
+    const auto NEXT = tail->next.load(std::memory_order_acquire);
+
+    if (!NEXT)
+        return false;
+
+    queueTail = NEXT;
+    out       = std::move(NEXT->msg);
+    toStdout  = NEXT->toStdout;
+
+    if (tail != &stubNode)
+        delete tail;
+
+    return true;
+}
+
+static void writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.length()) {
+        const auto RET = write(fd, data.c_str() + written, data.length() - written);
+        if (RET < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        written += RET;
+    }
+}
+
+// drains the queue into one buffer per sink, so a burst of lines costs one write() each
+static void drainQueue() {
+    std::string fileBatch, stdoutBatch, msg;
+    bool        toStdout = false;
+
+    while (popMessage(msg, toStdout)) {
+        fileBatch += msg;
+        fileBatch += '\n';
+
+        if (toStdout) {
+            stdoutBatch += msg;
+            stdoutBatch += '\n';
+        }
+    }
+
+    if (!fileBatch.empty() && logFD >= 0)
+        writeAll(logFD, fileBatch);
+
+    if (!stdoutBatch.empty())
+        writeAll(STDOUT_FILENO, stdoutBatch);
+}
 
 void Debug::init(const std::string& IS) {
     logFile = "/tmp/hypr/" + IS + (ISDEBUG ? "/hyprlandd.log" : "/hyprland.log");
+
+    logFD = open(logFile.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+    writerActive = true;
+    writerThread = std::thread([]() {
+        while (!writerStop) {
+            const auto SEQ = queueSeq.load();
+
+            {
+                std::lock_guard<std::mutex> lg(consumerMutex);
+                drainQueue();
+            }
+
+            queueSeq.wait(SEQ);
+        }
+    });
+
+    // exit() from anywhere (us, wlroots, a plugin) runs close() before the statics above are destroyed, so the thread is
+    // joined while its queue still exists and nothing queued is lost. Crashes get their lines out through flush().
+    static std::once_flag atexitOnce;
+    std::call_once(atexitOnce, []() { std::atexit(Debug::close); });
 }
 
-void Debug::wlrLog(wlr_log_importance level, const char* fmt, va_list args) {
-    char*         outputStr = nullptr;
+void Debug::close() {
+    if (!writerActive)
+        return;
 
-    std::ofstream ofs;
-    ofs.open(logFile, std::ios::out | std::ios::app);
+    writerStop   = true;
+    writerActive = false;
+    queueSeq.fetch_add(1);
+    queueSeq.notify_one();
 
-    vasprintf(&outputStr, fmt, args);
+    if (writerThread.joinable() && writerThread.get_id() != std::this_thread::get_id())
+        writerThread.join();
 
-    std::string output = std::string(outputStr);
-    free(outputStr);
+    std::lock_guard<std::mutex> lg(consumerMutex);
+
+    // whatever got queued after the writer's last batch
+    drainQueue();
+
+    if (logFD >= 0)
+        ::close(logFD);
+    logFD = -1;
+}
+
+void Debug::flush() {
+    // when crashing, the writer itself might be the one that died holding the lock. Don't hang on it forever.
+    std::unique_lock<std::mutex> lk(consumerMutex, std::defer_lock);
+    for (int i = 0; i < 100 && !lk.try_lock(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (!lk.owns_lock())
+        return;
+
+    drainQueue();
+}
+
+void Debug::pushMessage(LogLevel level, std::string&& msg) {
+    if (!writerActive) {
+        // nowhere to write to yet (e.g. early cmdline errors), just print it
+        if (!disableStdout)
+            std::cout << msg << "\n";
+        return;
+    }
+
+    const auto NODE = new SLogNode;
+    NODE->msg       = std::move(msg);
+    NODE->toStdout  = !disableStdout;
+
+    const auto PREV = queueHead.exchange(NODE, std::memory_order_acq_rel);
+    PREV->next.store(NODE, std::memory_order_release);
+
+    queueSeq.fetch_add(1, std::memory_order_release);
+
+    if (level == CRIT)
+        flush();
+    else
+        queueSeq.notify_one();
+}
+
+static Debug::STraceRingHeader* traceRing = nullptr;
+static std::once_flag           traceRingOnce;
 
-    ofs << "[wlr] " << output << "\n";
+static void openTraceRing() {
+    if (Debug::logFile.empty())
+        return;
+
+    const auto PATH = Debug::logFile.substr(0, Debug::logFile.find_last_of('.')) + ".trace";
+    const auto SIZE = sizeof(Debug::STraceRingHeader) + TRACERINGSIZE;
+
+    const auto FD = open(PATH.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (FD < 0)
+        return;
+
+    if (ftruncate(FD, SIZE) < 0) {
+        ::close(FD);
+        return;
+    }
+
+    const auto MAPPING = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+    ::close(FD);
+
+    if (MAPPING == MAP_FAILED)
+        return;
+
+    Dl_info info;
+    dladdr((void*)&Debug::init, &info);
+
+    traceRing             = new (MAPPING) Debug::STraceRingHeader;
+    traceRing->dataOffset = sizeof(Debug::STraceRingHeader);
+    traceRing->capacity   = TRACERINGSIZE;
+    traceRing->imageBase  = (uintptr_t)info.dli_fbase;
+    traceRing->writePos   = 0;
+}
 
-    ofs.close();
+static void copyIntoRing(uint64_t pos, const void* data, size_t len) {
+    const auto RINGDATA = (char*)traceRing + traceRing->dataOffset;
+    const auto START    = pos % traceRing->capacity;
+    const auto FIRST    = std::min<size_t>(len, traceRing->capacity - START);
+
+    memcpy(RINGDATA + START, data, FIRST);
+    if (FIRST < len)
+        memcpy(RINGDATA, (const char*)data + FIRST, len - FIRST);
+}
+
+void Debug::writeTraceRecord(LogLevel level, const char* fmt, const char* payload, size_t len, uint8_t argc) {
+    std::call_once(traceRingOnce, openTraceRing);
+
+    if (!traceRing)
+        return;
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    STraceRecordHeader header = {
+        .size        = (uint16_t)(sizeof(STraceRecordHeader) + len),
+        .level       = (uint8_t)level,
+        .argc        = argc,
+        .timestampNs = (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec,
+        .formatID    = (uintptr_t)fmt,
+    };
+
+    // reserve our slice, writers on different threads never overlap
+    const auto POS = std::atomic_ref<uint64_t>(traceRing->writePos).fetch_add(header.size, std::memory_order_relaxed);
+    header.pos     = POS;
+
+    copyIntoRing(POS, &header, sizeof(header));
+    copyIntoRing(POS + sizeof(header), payload, len);
+}
+
+void Debug::wlrLog(wlr_log_importance level, const char* fmt, va_list args) {
+    char* outputStr = nullptr;
+
+    vasprintf(&outputStr, fmt, args);
+
+    std::string output = "[wlr] " + std::string(outputStr);
+    free(outputStr);
 
-    if (!disableStdout)
-        std::cout << output << "\n";
+    pushMessage(LOG, std::move(output));
 }
@@ -5,10 +5,21 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <cstring>
+#include <algorithm>
 #include "../helpers/MiscFunctions.hpp"
 
 #define LOGMESSAGESIZE 1024
 
+// size of the memory-mapped binary trace ring
+#define TRACERINGSIZE (8 * 1024 * 1024)
+
+// messages with a severity below this (see Debug::logSeverity) are compiled out entirely.
+// 0 keeps everything, set with -DMIN_LOG_LEVEL in cmake / -Dmin_log_level in meson.
+#ifndef HYPRLAND_MIN_LOG_LEVEL
+#define HYPRLAND_MIN_LOG_LEVEL 0
+#endif
+
 enum LogLevel {
     NONE = -1,
     LOG  = 0,
@@ -25,16 +36,133 @@ namespace Debug {
     inline int64_t*    disableTime   = nullptr;
     inline bool        disableStdout = false;
     inline bool        trace         = false;
+    inline int64_t*    minLogLevel   = nullptr;
+    inline int64_t*    binaryTrace   = nullptr;
 
     void               init(const std::string& IS);
+    void               close();
+
+    // hands a finished line to the writer thread. Never blocks, the queue is lock-free.
+    void               pushMessage(LogLevel level, std::string&& msg);
+    // synchronously writes out everything queued so far. Called on CRIT and when crashing.
+    void               flush();
+
+    /*
+        Binary trace ring, used instead of text for LOG/INFO/TRACE when debug:binary_trace is on.
+        Nothing is formatted, a record is the format string's address (resolve it against imageBase in the
+        header and the binary's .rodata) plus the raw arguments, each prefixed with a one byte type tag:
+        'i' int64, 'u' uint64, 'f' double, 'b' bool, 'p' pointer, 'v' 2x double, 's' uint16 length + bytes.
+        Once the ring wraps, the oldest bytes are the tail of a half overwritten record. A reader resyncs by scanning forward from
+        writePos - capacity for a record header whose magic matches and whose pos is the position it was found at.
+    */
+    struct STraceRingHeader {
+        char     magic[8] = {'H', 'Y', 'P', 'R', 'T', 'R', 'C', '\0'};
+        uint32_t version  = 2;
+        uint32_t dataOffset;
+        uint64_t capacity;
+        uint64_t imageBase;
+        uint64_t writePos; // monotonic, the ring position is writePos % capacity
+    };
+
+    struct STraceRecordHeader {
+        uint32_t magic = 0x43525448; // "HTRC"
+        uint16_t size;               // including this header
+        uint8_t  level;
+        uint8_t  argc;
+        uint64_t pos;         // the writePos this record starts at, payload bytes matching the magic by chance won't match this too
+        uint64_t timestampNs; // CLOCK_MONOTONIC
+        uint64_t formatID;
+    };
+
+    void writeTraceRecord(LogLevel level, const char* fmt, const char* payload, size_t len, uint8_t argc);
+
+    constexpr int logSeverity(LogLevel level) {
+        switch (level) {
+            case TRACE: return 0;
+            case LOG: return 1;
+            case INFO: return 2;
+            case WARN: return 3;
+            case ERR: return 4;
+            case CRIT: return 5;
+            default: return 0;
+        }
+    }
+
+    template <typename T>
+    void encodeTraceArg(char*& it, char* const end, const T& arg) {
+        using DT = std::decay_t<T>;
+
+        const auto put = [&](char tag, const void* data, size_t len) {
+            if (it + 1 + len > end)
+                return;
+            *it++ = tag;
+            memcpy(it, data, len);
+            it += len;
+        };
+
+        const auto putString = [&](std::string_view str) {
+            if (it + 3 > end)
+                return;
+            const uint16_t LEN = std::min<size_t>(str.length(), end - it - 3);
+            put('s', &LEN, sizeof(LEN));
+            memcpy(it, str.data(), LEN);
+            it += LEN;
+        };
+
+        if constexpr (std::is_same_v<DT, bool>)
+            put('b', &arg, 1);
+        else if constexpr (std::is_floating_point_v<DT>) {
+            const double V = arg;
+            put('f', &V, sizeof(V));
+        } else if constexpr (std::is_enum_v<DT> || std::is_signed_v<DT>) {
+            const int64_t V = (int64_t)arg;
+            put('i', &V, sizeof(V));
+        } else if constexpr (std::is_integral_v<DT>) {
+            const uint64_t V = arg;
+            put('u', &V, sizeof(V));
+        } else if constexpr (std::is_convertible_v<const DT&, std::string_view>) {
+            // string_view of a null char* is UB, and null C strings do get logged
+            if constexpr (std::is_pointer_v<DT>)
+                putString(arg ? std::string_view{arg} : std::string_view{"(null)"});
+            else
+                putString(std::string_view{arg});
+        } else if constexpr (std::is_pointer_v<DT>) {
+            const uint64_t V = (uintptr_t)arg;
+            put('p', &V, sizeof(V));
+        } else if constexpr (std::is_same_v<DT, Vector2D>) {
+            const double V[2] = {arg.x, arg.y};
+            put('v', V, sizeof(V));
+        } else
+            putString(std::format("{}", arg)); // no raw representation, this one pays for formatting
+    }
+
+    template <typename... Args>
+    void logBinary(LogLevel level, std::string_view fmt, const Args&... args) {
+        char  payload[512];
+        char* it = payload;
+
+        (encodeTraceArg(it, payload + sizeof(payload), args), ...);
+
+        writeTraceRecord(level, fmt.data(), payload, it - payload, sizeof...(Args));
+    }
+
     template <typename... Args>
-    void log(LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+    void logImpl(LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
         if (disableLogs && *disableLogs)
             return;
 
         if (level == TRACE && !trace)
             return;
 
+        if (minLogLevel && logSeverity(level) < *minLogLevel)
+            return;
+
+        // warnings and worse are always kept as text, they're rare and we want them readable in crash reports
+        if (binaryTrace && *binaryTrace && logSeverity(level) < logSeverity(WARN)) {
+            logBinary(level, fmt.get(), args...);
+            return;
+        }
+
         std::string logMsg = "";
 
         switch (level) {
@@ -47,10 +175,6 @@ namespace Debug {
             default: break;
         }
 
-        // log to a file
-        std::ofstream ofs;
-        ofs.open(logFile, std::ios::out | std::ios::app);
-
         // print date and time to the ofs
         if (disableTime && !*disableTime) {
 #ifndef _LIBCPP_VERSION
@@ -69,13 +193,17 @@ namespace Debug {
         // 3. this is actually what std::format in stdlib does
         logMsg += std::vformat(fmt.get(), std::make_format_args(args...));
 
-        ofs << logMsg << "\n";
+        // the line is fully formatted here, on the caller, the writer thread only does the I/O
+        pushMessage(level, std::move(logMsg));
+    }
 
-        ofs.close();
+    // kept tiny and always inlined so that for a constant level below HYPRLAND_MIN_LOG_LEVEL the whole call folds away
+    template <typename... Args>
+    [[gnu::always_inline]] inline void log(LogLevel level, std::format_string<Args...> fmt, Args&&... args) {
+        if (logSeverity(level) < HYPRLAND_MIN_LOG_LEVEL)
+            return;
 
-        // log it to the stdout too.
-        if (!disableStdout)
-            std::cout << logMsg << "\n";
+        logImpl(level, fmt, std::forward<Args>(args)...);
     }
 
     void wlrLog(wlr_log_importance level, const char* fmt, va_list args);
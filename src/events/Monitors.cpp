@@ -149,6 +149,8 @@ void Events::listener_monitorFrame(void* owner, void* data) {
     if (!PMONITOR->m_bEnabled)
         return;
 
+    g_pInputManager->flushCoalescedMotion();
+
     g_pHyprRenderer->recheckSolitaryForMonitor(PMONITOR);
 
     PMONITOR->tearingState.busy = false;
@@ -167,6 +169,9 @@ void Events::listener_monitorFrame(void* owner, void* data) {
 
     PMONITOR->lastPresentationTimer.reset();
 
+    // advance this monitor's animations right before rendering it
+    g_pAnimationManager->tickMonitor(PMONITOR);
+
     if (*PENABLERAT && !PMONITOR->tearingState.nextRenderTorn) {
         if (!PMONITOR->RATScheduled) {
             // render
@@ -237,6 +242,7 @@ void Events::listener_monitorDamage(void* owner, void* data) {
     const auto PMONITOR = (CMonitor*)owner;
     const auto E        = (wlr_output_event_damage*)data;
 
+    g_pHyprOpenGL->invalidateBlurCaches(PMONITOR, const_cast<pixman_region32_t*>(E->damage));
     PMONITOR->addDamage(E->damage);
 }
 
@@ -260,3 +266,19 @@ void Events::listener_monitorCommit(void* owner, void* data) {
 void Events::listener_monitorBind(void* owner, void* data) {
     ;
 }
+
+void Events::listener_monitorPresent(void* owner, void* data) {
+    const auto PMONITOR = (CMonitor*)owner;
+
+    const auto E = (wlr_output_event_present*)data;
+
+    if (!E->presented || !E->when)
+        return;
+
+    // steady_clock is CLOCK_MONOTONIC, anything else can't be compared with it
+    if (wlr_backend_get_presentation_clock(g_pCompositor->m_sWLRBackend) != CLOCK_MONOTONIC)
+        return;
+
+    PMONITOR->lastPresentation    = std::chrono::steady_clock::time_point(std::chrono::seconds(E->when->tv_sec) + std::chrono::nanoseconds(E->when->tv_nsec));
+    PMONITOR->presentationRefresh = E->refresh;
+}
@@ -99,6 +99,8 @@ void Events::listener_newPopupXDG(void* owner, void* data) {
 
     ASSERT(PWINDOW);
 
+    g_pCompositor->m_sWindowHitIndex.invalidate(); // popup owners are tracked by the hit index
+
     if (!PWINDOW->m_bIsMapped)
         return;
 
@@ -149,6 +151,8 @@ void Events::listener_mapPopupXDG(void* owner, void* data) {
 
     Debug::log(LOG, "New XDG Popup mapped at {} {}", (int)PPOPUP->lx, (int)PPOPUP->ly);
 
+    g_pCompositor->m_sWindowHitIndex.invalidate();
+
     if (PPOPUP->parentWindow)
         PPOPUP->parentWindow->m_lPopupSurfaces.emplace_back(PPOPUP->popup->base->surface);
     else if (PPOPUP->parentLS)
@@ -191,6 +195,8 @@ void Events::listener_unmapPopupXDG(void* owner, void* data) {
 
     ASSERT(PPOPUP);
 
+    g_pCompositor->m_sWindowHitIndex.invalidate();
+
     if (PPOPUP->popup->base->surface == g_pCompositor->m_pLastFocus)
         g_pInputManager->releaseAllMouseButtons();
 
@@ -243,6 +249,8 @@ void Events::listener_destroyPopupXDG(void* owner, void* data) {
 
     Debug::log(LOG, "Destroyed popup XDG {:x}", (uintptr_t)PPOPUP);
 
+    g_pCompositor->m_sWindowHitIndex.invalidate();
+
     if (PPOPUP->pSurfaceTree) {
         SubsurfaceTree::destroySurfaceTree(PPOPUP->pSurfaceTree);
         PPOPUP->pSurfaceTree = nullptr;
@@ -1,6 +1,7 @@
 #include "AnimatedVariable.hpp"
 #include "../managers/AnimationManager.hpp"
 #include "../config/ConfigManager.hpp"
+#include "../Compositor.hpp"
 
 CAnimatedVariable::CAnimatedVariable() {
     ; // dummy var
@@ -13,6 +14,8 @@ void CAnimatedVariable::create(ANIMATEDVARTYPE type, SAnimationPropertyConfig* p
     m_pWindow       = pWindow;
 
     m_bDummy = false;
+
+    updateBezier();
 }
 
 void CAnimatedVariable::create(ANIMATEDVARTYPE type, std::any val, SAnimationPropertyConfig* pAnimConfig, void* pWindow, AVARDAMAGEPOLICY policy) {
@@ -66,11 +69,15 @@ void CAnimatedVariable::registerVar() {
 
 int CAnimatedVariable::getDurationLeftMs() {
     return std::max(
-        (int)(m_pConfig->pValues->internalSpeed * 100) - (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - animationBegin).count(), 0);
+        (int)(m_pConfig->pValues->internalSpeed * 100) - (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - animationBegin).count(), 0);
 }
 
 float CAnimatedVariable::getPercent() {
-    const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - animationBegin).count();
+    return getPercent(std::chrono::steady_clock::now());
+}
+
+float CAnimatedVariable::getPercent(const std::chrono::steady_clock::time_point& now) {
+    const auto DURATIONPASSED = std::chrono::duration_cast<std::chrono::milliseconds>(now - animationBegin).count();
     return std::clamp((DURATIONPASSED / 100.f) / m_pConfig->pValues->internalSpeed, 0.f, 1.f);
 }
 
@@ -80,19 +87,43 @@ float CAnimatedVariable::getCurveValue() {
     if (SPENT >= 1.f)
         return 1.f;
 
-    return g_pAnimationManager->getBezier(m_pConfig->pValues->internalBezier)->getYForPoint(SPENT);
+    if (!m_pBezier)
+        updateBezier();
+
+    return m_pBezier->getYForPoint(SPENT);
+}
+
+void CAnimatedVariable::updateBezier() {
+    // vars created before the animation manager resolve it when they first animate
+    if (!g_pAnimationManager || !m_pConfig)
+        return;
+
+    m_pBezier = g_pAnimationManager->getBezier(m_pConfig->pValues->internalBezier);
+
+    if (m_iLane != -1)
+        g_pAnimationManager->updateLane(this);
 }
 
 void CAnimatedVariable::connectToActive() {
-    g_pAnimationManager->scheduleTick(); // otherwise the animation manager will never pick this up
+    g_pAnimationManager->scheduleTickForVariable(this); // otherwise the animation manager will never pick this up
 
     if (!m_bIsConnectedToActive)
         g_pAnimationManager->m_vActiveAnimatedVariables.push_back(this);
 
     m_bIsConnectedToActive = true;
+
+    // begun and goal changed, already being connected or not
+    g_pAnimationManager->updateLane(this);
 }
 
 void CAnimatedVariable::disconnectFromActive() {
     std::erase_if(g_pAnimationManager->m_vActiveAnimatedVariables, [&](const auto& other) { return other == this; });
     m_bIsConnectedToActive = false;
-}
\ No newline at end of file
+
+    g_pAnimationManager->removeLane(this);
+}
+void CAnimatedVariable::onValueChanged() {
+    // window position / size moved, the pointer hit-test index has to pick it up
+    if (m_pWindow && m_eVarType == AVARTYPE_VECTOR && g_pCompositor)
+        g_pCompositor->m_sWindowHitIndex.invalidate();
+}
@@ -25,6 +25,7 @@ enum AVARDAMAGEPOLICY
 };
 
 class CAnimationManager;
+class CBezierCurve;
 class CWorkspace;
 struct SLayerSurface;
 struct SAnimationPropertyConfig;
@@ -82,7 +83,7 @@ class CAnimatedVariable {
             return *this;
 
         m_vGoal        = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_vBegun       = m_vValue;
 
         onAnimationBegin();
@@ -95,7 +96,7 @@ class CAnimatedVariable {
             return *this;
 
         m_fGoal        = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_fBegun       = m_fValue;
 
         onAnimationBegin();
@@ -108,7 +109,7 @@ class CAnimatedVariable {
             return *this;
 
         m_cGoal        = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_cBegun       = m_cValue;
 
         onAnimationBegin();
@@ -122,7 +123,7 @@ class CAnimatedVariable {
             return;
 
         m_vValue       = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_vBegun       = m_vValue;
 
         onAnimationBegin();
@@ -134,7 +135,7 @@ class CAnimatedVariable {
             return;
 
         m_fValue       = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_vBegun       = m_vValue;
 
         onAnimationBegin();
@@ -146,7 +147,7 @@ class CAnimatedVariable {
             return;
 
         m_cValue       = v;
-        animationBegin = std::chrono::system_clock::now();
+        animationBegin = std::chrono::steady_clock::now();
         m_vBegun       = m_vValue;
 
         onAnimationBegin();
@@ -194,14 +195,20 @@ class CAnimatedVariable {
 
         m_bIsBeingAnimated = false;
 
+        onValueChanged();
+
         if (endCallback)
             onAnimationEnd();
     }
 
     void setConfig(SAnimationPropertyConfig* pConfig) {
         m_pConfig = pConfig;
+        updateBezier();
     }
 
+    // resolves the config's curve once, instead of looking it up by name every tick. Redone on reloads by CAnimationManager::refreshBeziers
+    void updateBezier();
+
     SAnimationPropertyConfig* getConfig() {
         return m_pConfig;
     }
@@ -210,6 +217,7 @@ class CAnimatedVariable {
 
     /* returns the spent (completion) % */
     float getPercent();
+    float getPercent(const std::chrono::steady_clock::time_point& now);
 
     /* returns the current curve value */
     float getCurveValue();
@@ -266,12 +274,13 @@ class CAnimatedVariable {
     void*                                 m_pLayer     = nullptr;
 
     SAnimationPropertyConfig*             m_pConfig = nullptr;
+    CBezierCurve*                         m_pBezier = nullptr;
 
     bool                                  m_bDummy           = true;
     bool                                  m_bIsRegistered    = false;
     bool                                  m_bIsBeingAnimated = false;
 
-    std::chrono::system_clock::time_point animationBegin;
+    std::chrono::steady_clock::time_point animationBegin;
 
     ANIMATEDVARTYPE                       m_eVarType      = AVARTYPE_INVALID;
     AVARDAMAGEPOLICY                      m_eDamagePolicy = AVARDAMAGE_NONE;
@@ -283,8 +292,10 @@ class CAnimatedVariable {
     std::function<void(void* thisptr)>    m_fUpdateCallback;
 
     bool                                  m_bIsConnectedToActive = false;
+    int                                   m_iLane                = -1; // in the animation manager's lanes of m_eVarType, while connected to active
     void                                  connectToActive();
     void                                  disconnectFromActive();
+    void                                  onValueChanged();
 
     // methods
     void onAnimationEnd() {
@@ -303,6 +314,7 @@ class CAnimatedVariable {
     void onAnimationBegin() {
         m_bIsBeingAnimated = true;
         connectToActive();
+        onValueChanged();
 
         if (m_fBeginCallback) {
             m_fBeginCallback(this);
@@ -6,72 +6,157 @@
 #include <algorithm>
 
 void CBezierCurve::setup(std::vector<Vector2D>* pVec) {
-    m_dPoints.clear();
-
     const auto BEGIN = std::chrono::high_resolution_clock::now();
 
-    m_dPoints.emplace_back(Vector2D(0, 0));
-
-    for (auto& p : *pVec) {
-        m_dPoints.push_back(p);
+    RASSERT(pVec->size() == 2, "CBezierCurve only supports cubic beziers! (points num: {})", pVec->size() + 2);
+
+    const auto P1 = pVec->at(0);
+    const auto P2 = pVec->at(1);
+
+    // power basis of the curve through 0,0 P1 P2 1,1
+    const double CX = 3.0 * P1.x, BX = 3.0 * (P2.x - P1.x) - CX, AX = 1.0 - CX - BX;
+    const double CY = 3.0 * P1.y, BY = 3.0 * (P2.y - P1.y) - CY, AY = 1.0 - CY - BY;
+
+    m_fAX = AX;
+    m_fBX = BX;
+    m_fCX = CX;
+    m_fAY = AY;
+    m_fBY = BY;
+    m_fCY = CY;
+
+    // solve x(t) = x for the table in double, bisecting on from the previous entry as x is monotonic for any sane curve
+    double lastT = 0.0;
+    for (int i = 0; i <= BEZIERLUTSIZE; ++i) {
+        const double X  = (double)i / BEZIERLUTSIZE;
+        double       lo = lastT, hi = 1.0;
+
+        for (int step = 0; step < 32; ++step) {
+            const double MID = (lo + hi) / 2.0;
+            if (((AX * MID + BX) * MID + CX) * MID < X)
+                lo = MID;
+            else
+                hi = MID;
+        }
+
+        lastT       = (lo + hi) / 2.0;
+        m_aTForX[i] = lastT;
     }
 
-    m_dPoints.emplace_back(Vector2D(1, 1));
+    m_aTForX[0]             = 0.f;
+    m_aTForX[BEZIERLUTSIZE] = 1.f;
 
-    RASSERT(m_dPoints.size() == 4, "CBezierCurve only supports cubic beziers! (points num: {})", m_dPoints.size());
-
-    // bake BAKEDPOINTS points for faster lookups
-    // T -> X ( / BAKEDPOINTS )
-    for (int i = 0; i < BAKEDPOINTS; ++i) {
-        m_aPointsBaked[i] = Vector2D(getXForT((i + 1) / (float)BAKEDPOINTS), getYForT((i + 1) / (float)BAKEDPOINTS));
-    }
-
-    const auto ELAPSEDUS  = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGIN).count() / 1000.f;
-    const auto POINTSSIZE = m_aPointsBaked.size() * sizeof(m_aPointsBaked[0]) / 1000.f;
+    const auto ELAPSEDUS = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGIN).count() / 1000.f;
+    const auto LUTSIZE   = m_aTForX.size() * sizeof(m_aTForX[0]) / 1000.f;
 
     const auto BEGINCALC = std::chrono::high_resolution_clock::now();
     for (float i = 0.1f; i < 1.f; i += 0.1f)
         getYForPoint(i);
     const auto ELAPSEDCALCAVG = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - BEGINCALC).count() / 1000.f / 10.f;
 
-    Debug::log(LOG, "Created a bezier curve, baked {} points, mem usage: {:.2f}kB, time to bake: {:.2f}µs. Estimated average calc time: {:.2f}µs.", BAKEDPOINTS, POINTSSIZE,
+    Debug::log(LOG, "Created a bezier curve, baked {} segments, mem usage: {:.2f}kB, time to bake: {:.2f}µs. Estimated average calc time: {:.2f}µs.", BEZIERLUTSIZE, LUTSIZE,
                ELAPSEDUS, ELAPSEDCALCAVG);
 }
 
 float CBezierCurve::getYForT(float t) {
-    return 3 * t * pow(1 - t, 2) * m_dPoints[1].y + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].y + pow(t, 3);
+    return ((m_fAY * t + m_fBY) * t + m_fCY) * t;
 }
 
 float CBezierCurve::getXForT(float t) {
-    return 3 * t * pow(1 - t, 2) * m_dPoints[1].x + 3 * pow(t, 2) * (1 - t) * m_dPoints[2].x + pow(t, 3);
+    return ((m_fAX * t + m_fBX) * t + m_fCX) * t;
 }
 
-// Todo: this probably can be done better and faster
-float CBezierCurve::getYForPoint(float x) {
+float CBezierCurve::getXDerivativeForT(float t) {
+    return (3.f * m_fAX * t + 2.f * m_fBX) * t + m_fCX;
+}
+
+float CBezierCurve::getTForX(float x) {
+    if (x <= 0.f)
+        return 0.f;
+
     if (x >= 1.f)
         return 1.f;
 
-    int  index = 0;
-    bool below = true;
-    for (int step = (BAKEDPOINTS + 1) / 2; step > 0; step /= 2) {
-        if (below)
-            index += step;
-        else
-            index -= step;
+    const float POS   = x * BEZIERLUTSIZE;
+    const int   INDEX = std::min((int)POS, BEZIERLUTSIZE - 1);
+    const float LOWER = std::min(m_aTForX[INDEX], m_aTForX[INDEX + 1]);
+    const float UPPER = std::max(m_aTForX[INDEX], m_aTForX[INDEX + 1]);
+
+    float       t = m_aTForX[INDEX] + (m_aTForX[INDEX + 1] - m_aTForX[INDEX]) * (POS - INDEX);
+
+    // the table gets us close, newton gets us exact. Stay inside the table's segment
+    for (int i = 0; i < 4; ++i) {
+        const float DX = getXDerivativeForT(t);
 
-        below = m_aPointsBaked[index].x < x;
+        if (std::abs(DX) < 1e-6f)
+            break;
+
+        const float STEP = (getXForT(t) - x) / DX;
+
+        t = std::clamp(t - STEP, LOWER, UPPER);
+
+        if (std::abs(STEP) < 1e-5f)
+            return t;
     }
 
-    int lowerIndex = index - (!below || index == BAKEDPOINTS - 1);
+    // the slope is ~0 around here (e.g. a control point at x = 0), newton crawls. Bisect the segment instead.
+    float lo = LOWER, hi = UPPER;
+    for (int i = 0; i < 20; ++i) {
+        t = (lo + hi) / 2.f;
 
-    // in the name of performance i shall make a hack
-    const auto LOWERPOINT = &m_aPointsBaked[lowerIndex];
-    const auto UPPERPOINT = &m_aPointsBaked[lowerIndex + 1];
+        if (getXForT(t) < x)
+            lo = t;
+        else
+            hi = t;
+    }
 
-    const auto PERCINDELTA = (x - LOWERPOINT->x) / (UPPERPOINT->x - LOWERPOINT->x);
+    return (lo + hi) / 2.f;
+}
 
-    if (std::isnan(PERCINDELTA) || std::isinf(PERCINDELTA)) // can sometimes happen for VERY small x
-        return 0.f;
+float CBezierCurve::getYForPoint(float x) {
+    if (x >= 1.f)
+        return 1.f;
 
-    return LOWERPOINT->y + (UPPERPOINT->y - LOWERPOINT->y) * PERCINDELTA;
+    return getYForT(getTForX(x));
+}
+
+void CBezierCurve::getYForPoints(const float* x, float* out, size_t count) {
+    // the getTForX solve split into passes without early outs or calls, so each one vectorizes (the table lookup becomes a gather).
+    // Newton runs a fixed 4 steps here, the few values it can't settle (flat slope) go through the scalar path after.
+    constexpr size_t BLOCK = 64;
+
+    float            xs[BLOCK], ts[BLOCK];
+
+    for (size_t base = 0; base < count; base += BLOCK) {
+        const size_t N = std::min(BLOCK, count - base);
+
+        for (size_t i = 0; i < N; ++i) {
+            const float X     = std::clamp(x[base + i], 0.f, 1.f);
+            const float POS   = X * BEZIERLUTSIZE;
+            const int   INDEX = std::min((int)POS, BEZIERLUTSIZE - 1);
+            const float T0    = m_aTForX[INDEX];
+            const float T1    = m_aTForX[INDEX + 1];
+            const float LOWER = std::min(T0, T1);
+            const float UPPER = std::max(T0, T1);
+
+            float       t = T0 + (T1 - T0) * (POS - INDEX);
+
+            for (int step = 0; step < 4; ++step) {
+                const float DX = getXDerivativeForT(t);
+                t              = std::clamp(std::abs(DX) < 1e-6f ? t : t - (getXForT(t) - X) / DX, LOWER, UPPER);
+            }
+
+            xs[i] = X;
+            ts[i] = t;
+        }
+
+        // x and out may alias, x[base, base + N) is only read above
+        for (size_t i = 0; i < N; ++i) {
+            out[base + i] = xs[i] >= 1.f ? 1.f : getYForT(ts[i]);
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            if (std::abs(getXForT(ts[i]) - xs[i]) > 1e-5f)
+                out[base + i] = getYForPoint(xs[i]);
+        }
+    }
 }
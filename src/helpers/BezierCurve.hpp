@@ -1,15 +1,15 @@
 #pragma once
 
-#include <deque>
 #include <array>
 #include <vector>
 #include "Vector2D.hpp"
 
-constexpr int   BAKEDPOINTS    = 255;
-constexpr float INVBAKEDPOINTS = 1.f / BAKEDPOINTS;
+// segments of the uniform x -> t lookup table
+constexpr int BEZIERLUTSIZE = 256;
 
 // an implementation of a cubic bezier curve
-// might do better later
+// compiled on setup into polynomial coefficients and a uniform x -> t table,
+// so evaluating it is a direct index, a lerp and a couple of newton steps.
 class CBezierCurve {
   public:
     // sets up the bezier curve.
@@ -20,9 +20,17 @@ class CBezierCurve {
     float getXForT(float t);
     float getYForPoint(float x);
 
+    // evaluates getYForPoint for count values in vectorizable passes, in and out may be the same array
+    void  getYForPoints(const float* x, float* out, size_t count);
+
   private:
-    // this INCLUDES the 0,0 and 1,1 points.
-    std::deque<Vector2D>              m_dPoints;
+    float getTForX(float x);
+    float getXDerivativeForT(float t);
+
+    // x(t) = ((ax * t + bx) * t + cx) * t, same for y
+    float m_fAX = 0, m_fBX = 0, m_fCX = 0;
+    float m_fAY = 0, m_fBY = 0, m_fCY = 0;
 
-    std::array<Vector2D, BAKEDPOINTS> m_aPointsBaked;
+    // t for x = i / BEZIERLUTSIZE
+    std::array<float, BEZIERLUTSIZE + 1> m_aTForX;
 };
@@ -22,6 +22,10 @@ CMonitor::~CMonitor() {
     hyprListener_monitorNeedsFrame.removeCallback();
     hyprListener_monitorCommit.removeCallback();
     hyprListener_monitorBind.removeCallback();
+    hyprListener_monitorPresent.removeCallback();
+
+    if (animationTick)
+        wl_event_source_remove(animationTick);
 }
 
 void CMonitor::onConnect(bool noRule) {
@@ -32,6 +36,7 @@ void CMonitor::onConnect(bool noRule) {
     hyprListener_monitorNeedsFrame.removeCallback();
     hyprListener_monitorCommit.removeCallback();
     hyprListener_monitorBind.removeCallback();
+    hyprListener_monitorPresent.removeCallback();
     hyprListener_monitorFrame.initCallback(&output->events.frame, &Events::listener_monitorFrame, this);
     hyprListener_monitorDestroy.initCallback(&output->events.destroy, &Events::listener_monitorDestroy, this);
     hyprListener_monitorStateRequest.initCallback(&output->events.request_state, &Events::listener_monitorStateRequest, this);
@@ -39,6 +44,7 @@ void CMonitor::onConnect(bool noRule) {
     hyprListener_monitorNeedsFrame.initCallback(&output->events.needs_frame, &Events::listener_monitorNeedsFrame, this);
     hyprListener_monitorCommit.initCallback(&output->events.commit, &Events::listener_monitorCommit, this);
     hyprListener_monitorBind.initCallback(&output->events.bind, &Events::listener_monitorBind, this);
+    hyprListener_monitorPresent.initCallback(&output->events.present, &Events::listener_monitorPresent, this);
 
     tearingState.canTear = wlr_backend_is_drm(output->backend); // tearing only works on drm
 
@@ -122,6 +128,7 @@ void CMonitor::onConnect(bool noRule) {
 
     if (std::find_if(g_pCompositor->m_vMonitors.begin(), g_pCompositor->m_vMonitors.end(), [&](auto& other) { return other.get() == this; }) == g_pCompositor->m_vMonitors.end()) {
         g_pCompositor->m_vMonitors.push_back(*m_pThisWrap);
+        g_pCompositor->indexMonitor(this);
     }
 
     m_bEnabled = true;
@@ -157,7 +164,7 @@ void CMonitor::onConnect(bool noRule) {
     forceFullFrames = 3; // force 3 full frames to make sure there is no blinking due to double-buffering.
     //
 
-    g_pEventManager->postEvent(SHyprIPCEvent{"monitoradded", szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"monitoradded", szName, szName});
     EMIT_HOOK_EVENT("monitorAdded", this);
 
     if (!g_pCompositor->m_pLastMonitor) // set the last monitor if it isnt set yet
@@ -193,6 +200,13 @@ void CMonitor::onDisconnect() {
         renderTimer = nullptr;
     }
 
+    if (animationTick) {
+        wl_event_source_remove(animationTick);
+        animationTick = nullptr;
+    }
+
+    animationTickScheduled = false;
+
     if (!m_bEnabled || g_pCompositor->m_bIsShuttingDown)
         return;
 
@@ -229,6 +243,7 @@ void CMonitor::onDisconnect() {
     hyprListener_monitorNeedsFrame.removeCallback();
     hyprListener_monitorCommit.removeCallback();
     hyprListener_monitorBind.removeCallback();
+    hyprListener_monitorPresent.removeCallback();
 
     for (size_t i = 0; i < 4; ++i) {
         for (auto& ls : m_aLayerSurfaceLayers[i]) {
@@ -238,9 +253,11 @@ void CMonitor::onDisconnect() {
         m_aLayerSurfaceLayers[i].clear();
     }
 
+    g_pProtocolManager->m_pScreencopyProtocolManager->onMonitorRemoved(this);
+
     Debug::log(LOG, "Removed monitor {}!", szName);
 
-    g_pEventManager->postEvent(SHyprIPCEvent{"monitorremoved", szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"monitorremoved", szName, szName});
     EMIT_HOOK_EVENT("monitorRemoved", this);
 
     if (!BACKUPMON) {
@@ -298,6 +315,7 @@ void CMonitor::onDisconnect() {
     }
 
     std::erase_if(g_pCompositor->m_vMonitors, [&](std::shared_ptr<CMonitor>& el) { return el.get() == this; });
+    g_pCompositor->unindexMonitor(this);
 }
 
 void CMonitor::addDamage(const pixman_region32_t* rg) {
@@ -375,6 +393,7 @@ void CMonitor::setupDefaultWS(const SMonitorRule& monitorRule) {
         PNEWWORKSPACE = g_pCompositor->m_vWorkspaces.emplace_back(std::make_unique<CWorkspace>(ID, newDefaultWorkspaceName)).get();
 
         PNEWWORKSPACE->m_iID = WORKSPACEID;
+        g_pCompositor->indexWorkspace(PNEWWORKSPACE);
     }
 
     activeWorkspace = PNEWWORKSPACE->m_iID;
@@ -427,6 +446,7 @@ void CMonitor::setMirror(const std::string& mirrorOf) {
         if (std::find_if(g_pCompositor->m_vMonitors.begin(), g_pCompositor->m_vMonitors.end(), [&](auto& other) { return other.get() == this; }) ==
             g_pCompositor->m_vMonitors.end()) {
             g_pCompositor->m_vMonitors.push_back(*m_pThisWrap);
+            g_pCompositor->indexMonitor(this);
         }
 
         setupDefaultWS(RULE);
@@ -466,6 +486,7 @@ void CMonitor::setMirror(const std::string& mirrorOf) {
 
         // remove from mvmonitors
         std::erase_if(g_pCompositor->m_vMonitors, [&](const auto& other) { return other.get() == this; });
+        g_pCompositor->unindexMonitor(this);
 
         g_pCompositor->arrangeMonitors();
 
@@ -547,7 +568,7 @@ void CMonitor::changeWorkspace(CWorkspace* const pWorkspace, bool internal, bool
 
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(ID);
 
-        g_pEventManager->postEvent(SHyprIPCEvent{"workspace", pWorkspace->m_szName});
+        g_pEventManager->postEvent(SHyprIPCEvent{"workspace", pWorkspace->m_szName, szName});
         EMIT_HOOK_EVENT("workspace", pWorkspace);
     }
 
@@ -567,7 +588,7 @@ void CMonitor::setSpecialWorkspace(CWorkspace* const pWorkspace) {
         // remove special if exists
         if (const auto EXISTINGSPECIAL = g_pCompositor->getWorkspaceByID(specialWorkspaceID); EXISTINGSPECIAL) {
             EXISTINGSPECIAL->startAnim(false, false);
-            g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", "," + szName});
+            g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", "," + szName, szName});
         }
         specialWorkspaceID = 0;
 
@@ -593,7 +614,7 @@ void CMonitor::setSpecialWorkspace(CWorkspace* const pWorkspace) {
     if (PMONITORWORKSPACEOWNER->specialWorkspaceID == pWorkspace->m_iID) {
         PMONITORWORKSPACEOWNER->specialWorkspaceID = 0;
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(PMONITORWORKSPACEOWNER->ID);
-        g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", "," + PMONITORWORKSPACEOWNER->szName});
+        g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", "," + PMONITORWORKSPACEOWNER->szName, PMONITORWORKSPACEOWNER->szName});
         animate = false;
     }
 
@@ -617,7 +638,7 @@ void CMonitor::setSpecialWorkspace(CWorkspace* const pWorkspace) {
     else
         g_pInputManager->refocus();
 
-    g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", pWorkspace->m_szName + "," + szName});
+    g_pEventManager->postEvent(SHyprIPCEvent{"activespecial", pWorkspace->m_szName + "," + szName, szName});
 
     g_pHyprRenderer->damageMonitor(this);
 }
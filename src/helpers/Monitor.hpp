@@ -73,6 +73,10 @@ class CMonitor {
     bool                RATScheduled = false;
     CTimer              lastPresentationTimer;
 
+    // last vblank reported by the backend, on the monotonic clock. Unset until the first presentation
+    std::chrono::steady_clock::time_point lastPresentation;
+    int                                   presentationRefresh = 0; // ns, 0 if unknown
+
     SMonitorRule        activeMonitorRule;
 
     // mirroring
@@ -93,6 +97,10 @@ class CMonitor {
         bool frameScheduledWhileBusy = false;
     } tearingState;
 
+    // animations on this monitor are ticked right before its frames, the timer covers ticks without a frame
+    wl_event_source* animationTick          = nullptr;
+    bool             animationTickScheduled = false;
+
     // for the special workspace. 0 means not open.
     int                                                        specialWorkspaceID = 0;
 
@@ -105,6 +113,7 @@ class CMonitor {
     DYNLISTENER(monitorNeedsFrame);
     DYNLISTENER(monitorCommit);
     DYNLISTENER(monitorBind);
+    DYNLISTENER(monitorPresent);
 
     // methods
     void                       onConnect(bool noRule);
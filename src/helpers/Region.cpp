@@ -25,6 +25,10 @@ CRegion::CRegion(pixman_box32_t* box) {
     pixman_region32_init_rect(&m_rRegion, box->x1, box->y1, box->x2 - box->x1, box->y2 - box->y1);
 }
 
+CRegion::CRegion(const std::vector<pixman_box32_t>& boxes) {
+    pixman_region32_init_rects(&m_rRegion, boxes.data(), boxes.size());
+}
+
 CRegion::CRegion(const CRegion& other) {
     pixman_region32_init(&m_rRegion);
     pixman_region32_copy(&m_rRegion, const_cast<CRegion*>(&other)->pixman());
@@ -113,6 +117,14 @@ bool CRegion::empty() const {
     return !pixman_region32_not_empty(&m_rRegion);
 }
 
+uint64_t CRegion::area() const {
+    uint64_t area = 0;
+    for (auto& RECT : getRects()) {
+        area += (uint64_t)(RECT.x2 - RECT.x1) * (RECT.y2 - RECT.y1);
+    }
+    return area;
+}
+
 Vector2D CRegion::closestPoint(const Vector2D& vec) const {
     double   bestDist = __FLT_MAX__;
     Vector2D leader   = vec;
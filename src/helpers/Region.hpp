@@ -17,6 +17,8 @@ class CRegion {
     CRegion(wlr_box* box);
     /* Create from a pixman_box32_t */
     CRegion(pixman_box32_t* box);
+    /* Create from a list of boxes, merged in one pass */
+    CRegion(const std::vector<pixman_box32_t>& boxes);
 
     CRegion(const CRegion&);
     CRegion(CRegion&&);
@@ -46,6 +48,7 @@ class CRegion {
     wlr_box                     getExtents();
     bool                        containsPoint(const Vector2D& vec) const;
     bool                        empty() const;
+    uint64_t                    area() const;
     Vector2D                    closestPoint(const Vector2D& vec) const;
 
     std::vector<pixman_box32_t> getRects() const;
@@ -217,6 +217,10 @@ void Events::listener_unmapSubsurface(void* owner, void* data) {
 void Events::listener_commitSubsurface(void* owner, void* data) {
     SSurfaceTreeNode* pNode = (SSurfaceTreeNode*)owner;
 
+    // exports are rendered offscreen, visible or not
+    if (pNode->pWindowOwner)
+        g_pProtocolManager->m_pToplevelExportProtocolManager->invalidateWindow(pNode->pWindowOwner);
+
     // no damaging if it's not visible
     if (!g_pHyprRenderer->shouldRenderWindow(pNode->pWindowOwner)) {
         static auto* const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
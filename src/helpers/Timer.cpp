@@ -1,11 +1,11 @@
 #include "Timer.hpp"
 
 void CTimer::reset() {
-    m_tpLastReset = std::chrono::system_clock::now();
+    m_tpLastReset = std::chrono::steady_clock::now();
 }
 
-std::chrono::system_clock::duration CTimer::getDuration() {
-    return std::chrono::system_clock::now() - m_tpLastReset;
+std::chrono::steady_clock::duration CTimer::getDuration() {
+    return std::chrono::steady_clock::now() - m_tpLastReset;
 }
 
 int CTimer::getMillis() {
@@ -16,6 +16,6 @@ float CTimer::getSeconds() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(getDuration()).count() / 1000.f;
 }
 
-const std::chrono::system_clock::time_point& CTimer::chrono() const {
+const std::chrono::steady_clock::time_point& CTimer::chrono() const {
     return m_tpLastReset;
 }
\ No newline at end of file
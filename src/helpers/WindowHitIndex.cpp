@@ -0,0 +1,98 @@
+#include "WindowHitIndex.hpp"
+#include "../Compositor.hpp"
+
+// layout px per grid cell
+constexpr int          HITCELLSIZE = 256;
+// windows spanning more cells than this (huge / far off-screen boxes) are always returned instead of being rasterized
+constexpr int          HITMAXCELLS = 1024;
+
+static inline int      cellCoord(double v) {
+    return (int)std::floor(v / HITCELLSIZE);
+}
+
+static inline uint64_t cellKey(int x, int y) {
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
+
+void CWindowHitIndex::invalidate() {
+    m_bDirty = true;
+}
+
+void CWindowHitIndex::rebuild() {
+    static auto* const PRESIZEONBORDER   = &g_pConfigManager->getConfigValuePtr("general:resize_on_border")->intValue;
+    static auto* const PBORDERSIZE       = &g_pConfigManager->getConfigValuePtr("general:border_size")->intValue;
+    static auto* const PBORDERGRABEXTEND = &g_pConfigManager->getConfigValuePtr("general:extend_border_grab_area")->intValue;
+
+    const auto         GRABAREA          = *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
+
+    m_bDirty = false;
+
+    m_vEntries.clear();
+    m_mCells.clear();
+    m_vOversized.clear();
+    m_vPopupOwners.clear();
+
+    for (auto& w : g_pCompositor->m_vWindows) {
+        // every hit test requires the window to be mapped, (un)mapping invalidates the index.
+        if (!w->m_bIsMapped)
+            continue;
+
+        const auto BB  = w->getWindowInputBox();
+        wlr_box    box = {BB.x - GRABAREA, BB.y - GRABAREA, BB.width + 2 * GRABAREA, BB.height + 2 * GRABAREA};
+
+        const auto ID = (uint32_t)m_vEntries.size();
+        m_vEntries.emplace_back(SWindowHitEntry{w.get(), box});
+
+        if (!w->m_bIsX11 && !wl_list_empty(&w->m_uSurface.xdg->popups))
+            m_vPopupOwners.push_back(ID);
+
+        // cover the input box, the current (animated) box and the layout box, callers test against any of them.
+        const Vector2D TL = {std::min({(double)box.x, w->m_vRealPosition.vec().x, w->m_vPosition.x}),
+                             std::min({(double)box.y, w->m_vRealPosition.vec().y, w->m_vPosition.y})};
+        const Vector2D BR = {std::max({(double)box.x + box.width, w->m_vRealPosition.vec().x + w->m_vRealSize.vec().x, w->m_vPosition.x + w->m_vSize.x}),
+                             std::max({(double)box.y + box.height, w->m_vRealPosition.vec().y + w->m_vRealSize.vec().y, w->m_vPosition.y + w->m_vSize.y})};
+
+        const int      X1 = cellCoord(TL.x), Y1 = cellCoord(TL.y), X2 = cellCoord(BR.x), Y2 = cellCoord(BR.y);
+
+        if ((int64_t)(X2 - X1 + 1) * (Y2 - Y1 + 1) > HITMAXCELLS) {
+            m_vOversized.push_back(ID);
+            continue;
+        }
+
+        for (int x = X1; x <= X2; ++x) {
+            for (int y = Y1; y <= Y2; ++y) {
+                m_mCells[cellKey(x, y)].push_back(ID);
+            }
+        }
+    }
+}
+
+const std::vector<SWindowHitEntry*>& CWindowHitIndex::query(const Vector2D& a, const Vector2D& b) {
+    if (m_bDirty)
+        rebuild();
+
+    m_vScratch.clear();
+    m_vResult.clear();
+
+    const auto addCell = [&](const Vector2D& pos) {
+        if (const auto IT = m_mCells.find(cellKey(cellCoord(pos.x), cellCoord(pos.y))); IT != m_mCells.end())
+            m_vScratch.insert(m_vScratch.end(), IT->second.begin(), IT->second.end());
+    };
+
+    addCell(a);
+    if (cellCoord(a.x) != cellCoord(b.x) || cellCoord(a.y) != cellCoord(b.y))
+        addCell(b);
+
+    m_vScratch.insert(m_vScratch.end(), m_vOversized.begin(), m_vOversized.end());
+    m_vScratch.insert(m_vScratch.end(), m_vPopupOwners.begin(), m_vPopupOwners.end());
+
+    // ids are indices into m_vEntries, so sorting restores the stacking order
+    std::sort(m_vScratch.begin(), m_vScratch.end());
+    m_vScratch.erase(std::unique(m_vScratch.begin(), m_vScratch.end()), m_vScratch.end());
+
+    for (auto& id : m_vScratch) {
+        m_vResult.push_back(&m_vEntries[id]);
+    }
+
+    return m_vResult;
+}
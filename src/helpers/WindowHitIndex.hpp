@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "Vector2D.hpp"
+#include "../defines.hpp"
+
+class CWindow;
+
+struct SWindowHitEntry {
+    CWindow* pWindow = nullptr;
+    wlr_box  inputBox; // getWindowInputBox() grown by the resize_on_border grab area
+};
+
+/*  Uniform grid over layout coordinates answering "which windows can be under this point".
+    Entries keep m_vWindows' (bottom->top) order, so callers can run their usual z-ordered checks over the (few) candidates.
+    Only geometry and stacking are cached, the state checks (workspace, floating, hidden, ...) are left to the caller. */
+class CWindowHitIndex {
+  public:
+    // marks the index as stale, it will be rebuilt on the next query
+    void                                 invalidate();
+
+    // candidates which may contain either point or which have popups open, bottom->top. Valid until the next query.
+    const std::vector<SWindowHitEntry*>& query(const Vector2D& a, const Vector2D& b);
+
+  private:
+    void                                                rebuild();
+
+    bool                                                m_bDirty = true;
+
+    std::vector<SWindowHitEntry>                        m_vEntries;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_mCells;
+    std::vector<uint32_t>                               m_vOversized;
+    std::vector<uint32_t>                               m_vPopupOwners;
+
+    std::vector<uint32_t>                               m_vScratch;
+    std::vector<SWindowHitEntry*>                       m_vResult;
+};
@@ -24,16 +24,18 @@ CWorkspace::CWorkspace(int monitorID, std::string name, bool special) {
     m_vRenderOffset.registerVar();
     m_fAlpha.registerVar();
 
-    g_pEventManager->postEvent({"createworkspace", m_szName});
+    g_pEventManager->postEvent({"createworkspace", m_szName, PMONITOR->szName});
     EMIT_HOOK_EVENT("createWorkspace", this);
 }
 
 CWorkspace::~CWorkspace() {
+    g_pCompositor->unindexWorkspace(this);
+
     m_vRenderOffset.unregister();
 
     Debug::log(LOG, "Destroying workspace ID {}", m_iID);
 
-    g_pEventManager->postEvent({"destroyworkspace", m_szName});
+    g_pEventManager->postEvent({"destroyworkspace", m_szName, g_pCompositor->getMonitorNameFromID(m_iMonitorID)});
     EMIT_HOOK_EVENT("destroyWorkspace", this);
 }
 
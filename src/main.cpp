@@ -108,5 +108,7 @@ int main(int argc, char** argv) {
     Debug::log(LOG, "Hyprland reached the end.");
     g_pCompositor.reset();
 
+    Debug::close();
+
     return EXIT_SUCCESS;
 }
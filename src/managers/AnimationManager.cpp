@@ -8,16 +8,21 @@ int wlTick(void* data) {
 
     if (g_pCompositor->m_bSessionActive && g_pAnimationManager && g_pHookSystem && !g_pCompositor->m_bUnsafeState &&
         std::ranges::any_of(g_pCompositor->m_vMonitors, [](const auto& mon) { return mon->m_bEnabled && mon->output; })) {
-        g_pAnimationManager->tick();
+        g_pAnimationManager->tick(); // reschedules itself if needed
         EMIT_HOOK_EVENT("tick", nullptr);
-    }
-
-    if (g_pAnimationManager && g_pAnimationManager->shouldTickForNext())
+    } else if (g_pAnimationManager && g_pAnimationManager->shouldTickForNext())
         g_pAnimationManager->scheduleTick();
 
     return 0;
 }
 
+int wlMonitorTick(void* data) {
+    if (g_pAnimationManager)
+        g_pAnimationManager->tickMonitor((CMonitor*)data);
+
+    return 0;
+}
+
 CAnimationManager::CAnimationManager() {
     std::vector<Vector2D> points = {Vector2D(0, 0.75f), Vector2D(0.15f, 1.f)};
     m_mBezierCurves["default"].setup(&points);
@@ -43,11 +48,28 @@ void CAnimationManager::onTicked() {
     m_bTickScheduled = false;
 }
 
-void CAnimationManager::tick() {
-    static std::chrono::time_point lastTick = std::chrono::high_resolution_clock::now();
-    m_fLastTickTime                         = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - lastTick).count() / 1000.0;
-    lastTick                                = std::chrono::high_resolution_clock::now();
+void CAnimationManager::tickMonitor(CMonitor* pMonitor) {
+    if (!pMonitor->animationTickScheduled)
+        return;
+
+    pMonitor->animationTickScheduled = false;
+
+    if (!g_pCompositor->m_bSessionActive || !g_pHookSystem || g_pCompositor->m_bUnsafeState || !pMonitor->output) {
+        scheduleTickForMonitor(pMonitor);
+        return;
+    }
+
+    if (pMonitor == g_pHyprRenderer->m_pMostHzMonitor) {
+        static std::chrono::time_point lastTick = std::chrono::steady_clock::now();
+        m_fLastTickTime                         = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lastTick).count() / 1000.0;
+        lastTick                                = std::chrono::steady_clock::now();
+    }
+
+    tick(pMonitor); // reschedules itself if needed
+    EMIT_HOOK_EVENT("tick", nullptr);
+}
 
+void CAnimationManager::tick(CMonitor* pMonitor) {
     if (m_vActiveAnimatedVariables.empty())
         return;
 
@@ -60,10 +82,24 @@ void CAnimationManager::tick() {
 
     static auto* const              PSHADOWSENABLED = &g_pConfigManager->getConfigValuePtr("decoration:drop_shadow")->intValue;
 
-    const auto                      DEFAULTBEZIER = m_mBezierCurves.find("default");
-
     std::vector<CAnimatedVariable*> animationEndedVars;
 
+    // one timestamp for the whole tick, variables on a monitor use that monitor's frame time derived from it
+    const auto NOW = std::chrono::steady_clock::now();
+
+    m_vTickEntries.clear();
+    m_vTickFrameTimes.clear();
+    m_vTickOtherMonitors.clear();
+
+    m_vTickDamagedWindows.clear();
+    m_vTickDamagedWorkspaces.clear();
+    m_bTickFloatingDamaged = false;
+
+    bool stillAnimating = false; // on pMonitor, after this tick
+    bool frameScheduled = false;
+    bool kickGlobal     = false; // found variables for the global tick
+
+    // first pass: pick the variables this tick advances and fill in their lane's spent %, or mark them to be warped
     for (auto& av : m_vActiveAnimatedVariables) {
 
         if (av->m_eDamagePolicy == AVARDAMAGE_SHADOW && !*PSHADOWSENABLED) {
@@ -71,109 +107,105 @@ void CAnimationManager::tick() {
             continue;
         }
 
-        // get the spent % (0 - 1)
-        const float SPENT = av->getPercent();
-
         // window stuff
         const auto PWINDOW            = (CWindow*)av->m_pWindow;
         const auto PWORKSPACE         = (CWorkspace*)av->m_pWorkspace;
         const auto PLAYER             = (SLayerSurface*)av->m_pLayer;
-        CMonitor*  PMONITOR           = nullptr;
+        const auto PMONITOR           = getMonitorForVariable(av);
         bool       animationsDisabled = animGlobalDisabled;
 
-        wlr_box    WLRBOXPREV = {0, 0, 0, 0};
-        if (PWINDOW) {
-            WLRBOXPREV = PWINDOW->getFullWindowBoundingBox();
-            PMONITOR   = g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
-            if (!PMONITOR)
-                continue;
-            animationsDisabled = animationsDisabled || PWINDOW->m_sAdditionalConfigData.forceNoAnims;
-        } else if (PWORKSPACE) {
-            PMONITOR = g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
+        // every monitor advances only its own animations, the ones without a monitor are left to the global tick
+        if (PMONITOR != pMonitor) {
             if (!PMONITOR)
-                continue;
-            WLRBOXPREV = {(int)PMONITOR->vecPosition.x, (int)PMONITOR->vecPosition.y, (int)PMONITOR->vecSize.x, (int)PMONITOR->vecSize.y};
+                kickGlobal = true;
+            else if (!PMONITOR->animationTickScheduled && std::find(m_vTickOtherMonitors.begin(), m_vTickOtherMonitors.end(), PMONITOR) == m_vTickOtherMonitors.end())
+                m_vTickOtherMonitors.push_back(PMONITOR);
+            continue;
+        }
 
-            // TODO: just make this into a damn callback already vax...
-            for (auto& w : g_pCompositor->m_vWindows) {
-                if (!w->isHidden() && w->m_bIsMapped && w->m_bIsFloating)
-                    g_pHyprRenderer->damageWindow(w.get());
-            }
-        } else if (PLAYER) {
-            WLRBOXPREV = PLAYER->geometry;
-            PMONITOR   = g_pCompositor->getMonitorFromVector(Vector2D(PLAYER->geometry.x, PLAYER->geometry.y) + Vector2D(PLAYER->geometry.width, PLAYER->geometry.height) / 2.f);
-            if (!PMONITOR)
-                continue;
-            animationsDisabled = animationsDisabled || PLAYER->noAnimations;
+        // the owner is between monitors, wait for it to get one
+        if (!PMONITOR && (PWINDOW || PWORKSPACE || PLAYER)) {
+            stillAnimating = true;
+            continue;
         }
 
-        const bool VISIBLE = PWINDOW ? g_pCompositor->isWorkspaceVisible(PWINDOW->m_iWorkspaceID) : true;
+        if (PWINDOW)
+            animationsDisabled = animationsDisabled || PWINDOW->m_sAdditionalConfigData.forceNoAnims;
+        else if (PLAYER)
+            animationsDisabled = animationsDisabled || PLAYER->noAnimations;
+
+        // get the spent % (0 - 1)
+        const float SPENT = av->getPercent(PMONITOR ? getFrameTime(PMONITOR, NOW) : NOW);
+
+        auto&       entry = m_vTickEntries.emplace_back(SAnimationTickEntry{av, PMONITOR, -1});
 
-        // beziers are with a switch unforto
-        // TODO: maybe do something cleaner
+        // for disabled anims just warp
+        if (av->m_pConfig->pValues->internalEnabled == 0 || animationsDisabled || SPENT >= 1.f || av->m_iLane == -1)
+            continue;
 
         switch (av->m_eVarType) {
             case AVARTYPE_FLOAT: {
-                // for disabled anims just warp
-                if (av->m_pConfig->pValues->internalEnabled == 0 || animationsDisabled) {
-                    av->warp(false);
-                    break;
-                }
-
-                if (SPENT >= 1.f || av->m_fBegun == av->m_fGoal) {
-                    av->warp(false);
+                if (av->m_fBegun == av->m_fGoal)
                     break;
-                }
-
-                const auto DELTA  = av->m_fGoal - av->m_fBegun;
-                const auto BEZIER = m_mBezierCurves.find(av->m_pConfig->pValues->internalBezier);
 
-                if (BEZIER != m_mBezierCurves.end())
-                    av->m_fValue = av->m_fBegun + BEZIER->second.getYForPoint(SPENT) * DELTA;
-                else
-                    av->m_fValue = av->m_fBegun + DEFAULTBEZIER->second.getYForPoint(SPENT) * DELTA;
+                entry.lane                       = av->m_iLane;
+                m_sFloatLanes.spent[av->m_iLane] = SPENT;
                 break;
             }
             case AVARTYPE_VECTOR: {
-                // for disabled anims just warp
-                if (av->m_pConfig->pValues->internalEnabled == 0 || animationsDisabled) {
-                    av->warp(false);
+                if (av->m_vBegun == av->m_vGoal)
                     break;
-                }
-
-                if (SPENT >= 1.f || av->m_vBegun == av->m_vGoal) {
-                    av->warp(false);
-                    break;
-                }
-
-                const auto DELTA  = av->m_vGoal - av->m_vBegun;
-                const auto BEZIER = m_mBezierCurves.find(av->m_pConfig->pValues->internalBezier);
 
-                if (BEZIER != m_mBezierCurves.end())
-                    av->m_vValue = av->m_vBegun + DELTA * BEZIER->second.getYForPoint(SPENT);
-                else
-                    av->m_vValue = av->m_vBegun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
+                entry.lane                        = av->m_iLane;
+                m_sVectorLanes.spent[av->m_iLane] = SPENT;
                 break;
             }
             case AVARTYPE_COLOR: {
-                // for disabled anims just warp
-                if (av->m_pConfig->pValues->internalEnabled == 0 || animationsDisabled) {
-                    av->warp(false);
+                if (av->m_cBegun == av->m_cGoal)
                     break;
-                }
 
-                if (SPENT >= 1.f || av->m_cBegun == av->m_cGoal) {
-                    av->warp(false);
-                    break;
-                }
+                entry.lane                       = av->m_iLane;
+                m_sColorLanes.spent[av->m_iLane] = SPENT;
+                break;
+            }
+            default: {
+                ;
+            }
+        }
+    }
+
+    // second pass: interpolate every lane of a type at once. Lanes of other monitors' variables come along, their result just isn't used
+    m_sFloatLanes.interpolate();
+    m_sVectorLanes.interpolate();
+    m_sColorLanes.interpolate();
 
-                const auto DELTA  = av->m_cGoal - av->m_cBegun;
-                const auto BEZIER = m_mBezierCurves.find(av->m_pConfig->pValues->internalBezier);
+    // damage is merged per monitor and submitted once, at the end of the pass
+    g_pHyprRenderer->beginDamageBatch();
 
-                if (BEZIER != m_mBezierCurves.end())
-                    av->m_cValue = av->m_cBegun + DELTA * BEZIER->second.getYForPoint(SPENT);
-                else
-                    av->m_cValue = av->m_cBegun + DELTA * DEFAULTBEZIER->second.getYForPoint(SPENT);
+    // last pass: write the values back, damage and notify only what actually changed
+    for (auto& entry : m_vTickEntries) {
+        const auto av       = entry.av;
+        const auto PWINDOW  = (CWindow*)av->m_pWindow;
+        const auto PMONITOR = entry.monitor;
+
+        bool       changed = false;
+
+        switch (av->m_eVarType) {
+            case AVARTYPE_FLOAT: {
+                const auto VALUE = entry.lane == -1 ? av->m_fGoal : m_sFloatLanes.out[0][entry.lane];
+                changed          = VALUE != av->m_fValue;
+                break;
+            }
+            case AVARTYPE_VECTOR: {
+                const auto VALUE = entry.lane == -1 ? av->m_vGoal : Vector2D{m_sVectorLanes.out[0][entry.lane], m_sVectorLanes.out[1][entry.lane]};
+                changed          = VALUE != av->m_vValue;
+                break;
+            }
+            case AVARTYPE_COLOR: {
+                const auto VALUE = entry.lane == -1 ? av->m_cGoal :
+                                                      CColor{m_sColorLanes.out[0][entry.lane], m_sColorLanes.out[1][entry.lane], m_sColorLanes.out[2][entry.lane],
+                                                             m_sColorLanes.out[3][entry.lane]};
+                changed          = !(VALUE == av->m_cValue);
                 break;
             }
             default: {
@@ -181,6 +213,26 @@ void CAnimationManager::tick() {
             }
         }
 
+        wlr_box WLRBOXPREV = {0, 0, 0, 0};
+        if (changed)
+            WLRBOXPREV = prepareDamage(av, PMONITOR);
+
+        if (entry.lane == -1)
+            av->warp(false);
+        else {
+            switch (av->m_eVarType) {
+                case AVARTYPE_FLOAT: av->m_fValue = m_sFloatLanes.out[0][entry.lane]; break;
+                case AVARTYPE_VECTOR:
+                    av->m_vValue = {m_sVectorLanes.out[0][entry.lane], m_sVectorLanes.out[1][entry.lane]};
+                    av->onValueChanged();
+                    break;
+                case AVARTYPE_COLOR:
+                    av->m_cValue = {m_sColorLanes.out[0][entry.lane], m_sColorLanes.out[1][entry.lane], m_sColorLanes.out[2][entry.lane], m_sColorLanes.out[3][entry.lane]};
+                    break;
+                default: break;
+            }
+        }
+
         // set size and pos if valid, but only if damage policy entire (dont if border for example)
         if (g_pCompositor->windowValidMapped(PWINDOW) && av->m_eDamagePolicy == AVARDAMAGE_ENTIRE && PWINDOW->m_iX11Type != 2)
             g_pXWaylandManager->setWindowSize(PWINDOW, PWINDOW->m_vRealSize.goalv());
@@ -188,8 +240,23 @@ void CAnimationManager::tick() {
         // check if we did not finish animating. If so, trigger onAnimationEnd.
         if (!av->isBeingAnimated())
             animationEndedVars.push_back(av);
+        else
+            stillAnimating = true;
+
+        // nothing moved (e.g. the curve is still flat), nothing to redraw
+        if (!changed)
+            continue;
+
+        // toplevel exports render the window offscreen, visible or not
+        if (PWINDOW)
+            g_pProtocolManager->m_pToplevelExportProtocolManager->invalidateWindow(PWINDOW);
+
+        const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace;
+        const auto PLAYER     = (SLayerSurface*)av->m_pLayer;
 
         // lastly, handle damage, but only if whatever we are animating is visible.
+        const bool VISIBLE = PWINDOW ? g_pCompositor->isWorkspaceVisible(PWINDOW->m_iWorkspaceID) : true;
+
         if (!VISIBLE)
             continue;
 
@@ -200,19 +267,13 @@ void CAnimationManager::tick() {
             case AVARDAMAGE_ENTIRE: {
                 g_pHyprRenderer->damageBox(&WLRBOXPREV);
 
+                // a window / workspace usually animates a few variables at once, their decos only need updating for the final state
                 if (PWINDOW) {
-                    PWINDOW->updateWindowDecos();
-                    g_pHyprRenderer->damageWindow(PWINDOW);
+                    if (std::find(m_vTickDamagedWindows.begin(), m_vTickDamagedWindows.end(), PWINDOW) == m_vTickDamagedWindows.end())
+                        m_vTickDamagedWindows.push_back(PWINDOW);
                 } else if (PWORKSPACE) {
-                    for (auto& w : g_pCompositor->m_vWindows) {
-                        if (!w->m_bIsMapped || w->isHidden())
-                            continue;
-
-                        if (w->m_iWorkspaceID != PWORKSPACE->m_iID)
-                            continue;
-
-                        w->updateWindowDecos();
-                    }
+                    if (std::find(m_vTickDamagedWorkspaces.begin(), m_vTickDamagedWorkspaces.end(), PWORKSPACE->m_iID) == m_vTickDamagedWorkspaces.end())
+                        m_vTickDamagedWorkspaces.push_back(PWORKSPACE->m_iID);
                 } else if (PLAYER) {
                     if (PLAYER->layer == ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND || PLAYER->layer == ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM)
                         g_pHyprOpenGL->markBlurDirtyForMonitor(PMONITOR);
@@ -280,8 +341,43 @@ void CAnimationManager::tick() {
         }
 
         // manually schedule a frame
-        if (PMONITOR)
+        if (PMONITOR) {
             g_pCompositor->scheduleFrameForMonitor(PMONITOR);
+            frameScheduled = true;
+        }
+    }
+
+    for (auto& w : m_vTickDamagedWindows) {
+        w->updateWindowDecos();
+        g_pHyprRenderer->damageWindow(w);
+    }
+
+    if (!m_vTickDamagedWorkspaces.empty()) {
+        for (auto& w : g_pCompositor->m_vWindows) {
+            if (!w->m_bIsMapped || w->isHidden())
+                continue;
+
+            if (std::find(m_vTickDamagedWorkspaces.begin(), m_vTickDamagedWorkspaces.end(), w->m_iWorkspaceID) == m_vTickDamagedWorkspaces.end())
+                continue;
+
+            w->updateWindowDecos();
+        }
+    }
+
+    g_pHyprRenderer->endDamageBatch();
+
+    for (auto& m : m_vTickOtherMonitors) {
+        scheduleTickForMonitor(m);
+    }
+
+    if (kickGlobal)
+        scheduleTick();
+
+    if (stillAnimating) {
+        if (pMonitor)
+            scheduleTickForMonitor(pMonitor, frameScheduled);
+        else
+            scheduleTick();
     }
 
     // do it here, because if this alters the animation vars deque we would be in trouble above.
@@ -290,6 +386,57 @@ void CAnimationManager::tick() {
     }
 }
 
+wlr_box CAnimationManager::prepareDamage(CAnimatedVariable* av, CMonitor* pMonitor) {
+    const auto PWINDOW    = (CWindow*)av->m_pWindow;
+    const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace;
+    const auto PLAYER     = (SLayerSurface*)av->m_pLayer;
+
+    if (PWINDOW)
+        return PWINDOW->getFullWindowBoundingBox();
+
+    if (PWORKSPACE) {
+        // TODO: just make this into a damn callback already vax...
+        // the damage is batched, so once per tick covers every workspace animating in it
+        if (!m_bTickFloatingDamaged) {
+            m_bTickFloatingDamaged = true;
+
+            for (auto& w : g_pCompositor->m_vWindows) {
+                if (!w->isHidden() && w->m_bIsMapped && w->m_bIsFloating)
+                    g_pHyprRenderer->damageWindow(w.get());
+            }
+        }
+
+        return {(int)pMonitor->vecPosition.x, (int)pMonitor->vecPosition.y, (int)pMonitor->vecSize.x, (int)pMonitor->vecSize.y};
+    }
+
+    if (PLAYER)
+        return PLAYER->geometry;
+
+    return {0, 0, 0, 0};
+}
+
+std::chrono::steady_clock::time_point CAnimationManager::getFrameTime(CMonitor* pMonitor, const std::chrono::steady_clock::time_point& now) {
+    for (auto& [mon, time] : m_vTickFrameTimes) {
+        if (mon == pMonitor)
+            return time;
+    }
+
+    const auto REFRESHNS = pMonitor->presentationRefresh > 0 ? (int64_t)pMonitor->presentationRefresh :
+                                                               (pMonitor->refreshRate > 0 ? (int64_t)(1000000000.0 / pMonitor->refreshRate) : 0);
+    const auto PERIOD    = std::chrono::nanoseconds(REFRESHNS);
+
+    auto       frameTime = now;
+
+    // whatever we animate now will be on screen at the next vblank, not when the timer fired.
+    // Without a presentation yet (or a bogus one) there's nothing to align to.
+    if (PERIOD.count() > 0 && pMonitor->lastPresentation.time_since_epoch().count() != 0 && pMonitor->lastPresentation <= now)
+        frameTime = pMonitor->lastPresentation + PERIOD * ((now - pMonitor->lastPresentation) / PERIOD + 1);
+
+    m_vTickFrameTimes.emplace_back(pMonitor, frameTime);
+
+    return frameTime;
+}
+
 bool CAnimationManager::deltaSmallToFlip(const Vector2D& a, const Vector2D& b) {
     return std::abs(a.x - b.x) < 0.5f && std::abs(a.y - b.y) < 0.5f;
 }
@@ -407,13 +554,13 @@ void CAnimationManager::animationSlide(CWindow* pWindow, std::string force, bool
 
 void CAnimationManager::onWindowPostCreateClose(CWindow* pWindow, bool close) {
     if (!close) {
-        pWindow->m_vRealPosition.m_pConfig = g_pConfigManager->getAnimationPropertyConfig("windowsIn");
-        pWindow->m_vRealSize.m_pConfig     = g_pConfigManager->getAnimationPropertyConfig("windowsIn");
-        pWindow->m_fAlpha.m_pConfig        = g_pConfigManager->getAnimationPropertyConfig("fadeIn");
+        pWindow->m_vRealPosition.setConfig(g_pConfigManager->getAnimationPropertyConfig("windowsIn"));
+        pWindow->m_vRealSize.setConfig(g_pConfigManager->getAnimationPropertyConfig("windowsIn"));
+        pWindow->m_fAlpha.setConfig(g_pConfigManager->getAnimationPropertyConfig("fadeIn"));
     } else {
-        pWindow->m_vRealPosition.m_pConfig = g_pConfigManager->getAnimationPropertyConfig("windowsOut");
-        pWindow->m_vRealSize.m_pConfig     = g_pConfigManager->getAnimationPropertyConfig("windowsOut");
-        pWindow->m_fAlpha.m_pConfig        = g_pConfigManager->getAnimationPropertyConfig("fadeOut");
+        pWindow->m_vRealPosition.setConfig(g_pConfigManager->getAnimationPropertyConfig("windowsOut"));
+        pWindow->m_vRealSize.setConfig(g_pConfigManager->getAnimationPropertyConfig("windowsOut"));
+        pWindow->m_fAlpha.setConfig(g_pConfigManager->getAnimationPropertyConfig("fadeOut"));
     }
 
     auto ANIMSTYLE = pWindow->m_vRealPosition.m_pConfig->pValues->internalStyle;
@@ -526,6 +673,68 @@ std::string CAnimationManager::styleValidInConfigVar(const std::string& config,
     return "";
 }
 
+void CAnimationManager::updateLane(CAnimatedVariable* av) {
+    if (!av->m_pBezier)
+        av->m_pBezier = getBezier(av->m_pConfig->pValues->internalBezier);
+
+    switch (av->m_eVarType) {
+        case AVARTYPE_FLOAT: {
+            if (av->m_iLane == -1)
+                av->m_iLane = m_sFloatLanes.add(av);
+
+            m_sFloatLanes.set(av->m_iLane, {av->m_fBegun}, {av->m_fGoal - av->m_fBegun}, av->m_pBezier);
+            break;
+        }
+        case AVARTYPE_VECTOR: {
+            if (av->m_iLane == -1)
+                av->m_iLane = m_sVectorLanes.add(av);
+
+            const auto DELTA = av->m_vGoal - av->m_vBegun;
+            m_sVectorLanes.set(av->m_iLane, {av->m_vBegun.x, av->m_vBegun.y}, {DELTA.x, DELTA.y}, av->m_pBezier);
+            break;
+        }
+        case AVARTYPE_COLOR: {
+            if (av->m_iLane == -1)
+                av->m_iLane = m_sColorLanes.add(av);
+
+            const auto DELTA = av->m_cGoal - av->m_cBegun;
+            m_sColorLanes.set(av->m_iLane, {av->m_cBegun.r, av->m_cBegun.g, av->m_cBegun.b, av->m_cBegun.a}, {DELTA.r, DELTA.g, DELTA.b, DELTA.a}, av->m_pBezier);
+            break;
+        }
+        default: break;
+    }
+}
+
+void CAnimationManager::removeLane(CAnimatedVariable* av) {
+    if (av->m_iLane == -1)
+        return;
+
+    CAnimatedVariable* moved = nullptr;
+
+    switch (av->m_eVarType) {
+        case AVARTYPE_FLOAT: moved = m_sFloatLanes.remove(av->m_iLane); break;
+        case AVARTYPE_VECTOR: moved = m_sVectorLanes.remove(av->m_iLane); break;
+        case AVARTYPE_COLOR: moved = m_sColorLanes.remove(av->m_iLane); break;
+        default: UNREACHABLE();
+    }
+
+    if (moved)
+        moved->m_iLane = av->m_iLane;
+
+    av->m_iLane = -1;
+}
+
+void CAnimationManager::refreshBeziers() {
+    // the curves were recreated (or a config points to another one), the resolved pointers would dangle
+    for (auto& av : m_vAnimatedVariables) {
+        av->updateBezier();
+    }
+
+    for (auto& av : m_vActiveAnimatedVariables) {
+        av->updateBezier();
+    }
+}
+
 CBezierCurve* CAnimationManager::getBezier(const std::string& name) {
     const auto BEZIER = std::find_if(m_mBezierCurves.begin(), m_mBezierCurves.end(), [&](const auto& other) { return other.first == name; });
 
@@ -540,6 +749,46 @@ bool CAnimationManager::shouldTickForNext() {
     return !m_vActiveAnimatedVariables.empty();
 }
 
+CMonitor* CAnimationManager::getMonitorForVariable(CAnimatedVariable* av) {
+    if (const auto PWINDOW = (CWindow*)av->m_pWindow; PWINDOW)
+        return g_pCompositor->getMonitorFromID(PWINDOW->m_iMonitorID);
+
+    if (const auto PWORKSPACE = (CWorkspace*)av->m_pWorkspace; PWORKSPACE)
+        return g_pCompositor->getMonitorFromID(PWORKSPACE->m_iMonitorID);
+
+    if (const auto PLAYER = (SLayerSurface*)av->m_pLayer; PLAYER)
+        return g_pCompositor->getMonitorFromVector(Vector2D(PLAYER->geometry.x, PLAYER->geometry.y) + Vector2D(PLAYER->geometry.width, PLAYER->geometry.height) / 2.f);
+
+    return nullptr;
+}
+
+void CAnimationManager::scheduleTickForVariable(CAnimatedVariable* av) {
+    if (const auto PMONITOR = getMonitorForVariable(av); PMONITOR)
+        scheduleTickForMonitor(PMONITOR);
+    else
+        scheduleTick();
+}
+
+void CAnimationManager::scheduleTickForMonitor(CMonitor* pMonitor, bool frameScheduled) {
+    if (pMonitor->animationTickScheduled)
+        return;
+
+    pMonitor->animationTickScheduled = true;
+
+    if (!pMonitor->animationTick)
+        pMonitor->animationTick = wl_event_loop_add_timer(g_pCompositor->m_sWLEventLoop, &wlMonitorTick, pMonitor);
+
+    // with a frame on its way the next tick happens right before it's rendered, the timer only fires if it never comes
+    // (e.g. nothing visible changed). Otherwise aim for this monitor's next vblank.
+    const float REFRESHDELAYMS = std::floor(1000.f / pMonitor->refreshRate);
+
+    const float SINCEPRES = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - pMonitor->lastPresentationTimer.chrono()).count() / 1000.f;
+
+    const auto  TOPRES = std::clamp((frameScheduled ? 2 : 1) * REFRESHDELAYMS - SINCEPRES, 1.1f, 1000.f); // we can't send 0, that will disarm it
+
+    wl_event_source_timer_update(pMonitor->animationTick, std::floor(TOPRES));
+}
+
 void CAnimationManager::scheduleTick() {
     if (m_bTickScheduled)
         return;
@@ -555,7 +804,7 @@ void CAnimationManager::scheduleTick() {
 
     float       refreshDelayMs = std::floor(1000.f / PMOSTHZ->refreshRate);
 
-    const float SINCEPRES = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - PMOSTHZ->lastPresentationTimer.chrono()).count() / 1000.f;
+    const float SINCEPRES = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - PMOSTHZ->lastPresentationTimer.chrono()).count() / 1000.f;
 
     const auto  TOPRES = std::clamp(refreshDelayMs - SINCEPRES, 1.1f, 1000.f); // we can't send 0, that will disarm it
 
@@ -7,20 +7,127 @@
 #include "../helpers/BezierCurve.hpp"
 #include "../Window.hpp"
 #include "../helpers/Timer.hpp"
+#include <array>
+
+class CMonitor;
+
+// one lane per active animated variable of a type, with the components split into contiguous arrays
+// so that interpolating all of them in a tick is a handful of branchless, vectorizable loops.
+// A variable gets its lane when it connects to active and gives it back (swap and pop) when it disconnects,
+// begun / delta / curve are written when its animation (re)starts, so a tick only fills in the spent %.
+template <typename T, size_t N>
+struct SAnimationLanes {
+    std::vector<CAnimatedVariable*> vars; // the owner of each lane, its m_iLane points back
+    std::vector<CBezierCurve*>      curves;
+    std::vector<float>              spent;    // written by tick() for the lanes it advances
+    std::vector<float>              progress; // the bezier value for spent
+    std::array<std::vector<T>, N>   begun;
+    std::array<std::vector<T>, N>   delta;
+    std::array<std::vector<T>, N>   out; // only written by interpolate(), lanes moving around in between don't touch it
+
+    int                             add(CAnimatedVariable* av) {
+        vars.push_back(av);
+        curves.push_back(nullptr);
+        spent.push_back(0.f);
+        progress.push_back(0.f);
+
+        for (size_t i = 0; i < N; ++i) {
+            begun[i].push_back(0);
+            delta[i].push_back(0);
+        }
+
+        return vars.size() - 1;
+    }
+
+    void set(int lane, const std::array<T, N>& b, const std::array<T, N>& d, CBezierCurve* pCurve) {
+        for (size_t i = 0; i < N; ++i) {
+            begun[i][lane] = b[i];
+            delta[i][lane] = d[i];
+        }
+
+        curves[lane] = pCurve;
+    }
+
+    // returns the variable now in lane, the last one moved over, or nullptr if lane was the last
+    CAnimatedVariable* remove(int lane) {
+        const size_t LAST = vars.size() - 1;
+
+        vars[lane]     = vars[LAST];
+        curves[lane]   = curves[LAST];
+        spent[lane]    = spent[LAST];
+        progress[lane] = progress[LAST];
+
+        for (size_t i = 0; i < N; ++i) {
+            begun[i][lane] = begun[i][LAST];
+            delta[i][lane] = delta[i][LAST];
+            begun[i].pop_back();
+            delta[i].pop_back();
+        }
+
+        vars.pop_back();
+        curves.pop_back();
+        spent.pop_back();
+        progress.pop_back();
+
+        return (size_t)lane == LAST ? nullptr : vars[lane];
+    }
+
+    void interpolate() {
+        const size_t LANES = vars.size();
+
+        // variables of one window / layer / workspace usually start together and share their curve, so batch the runs of it
+        for (size_t start = 0, end = 0; start < LANES; start = end) {
+            while (end < LANES && curves[end] == curves[start]) {
+                ++end;
+            }
+
+            curves[start]->getYForPoints(&spent[start], &progress[start], end - start);
+        }
+
+        const float* PCURVE = progress.data();
+
+        for (size_t i = 0; i < N; ++i) {
+            out[i].resize(LANES);
+
+            const T* PBEGUN = begun[i].data();
+            const T* PDELTA = delta[i].data();
+            T*       POUT   = out[i].data();
+
+            for (size_t l = 0; l < LANES; ++l) {
+                POUT[l] = PBEGUN[l] + PDELTA[l] * PCURVE[l];
+            }
+        }
+    }
+};
+
+struct SAnimationTickEntry {
+    CAnimatedVariable* av      = nullptr;
+    CMonitor*          monitor = nullptr;
+    int                lane    = -1; // in the lanes of av's type, -1 warps to the goal
+};
 
 class CAnimationManager {
   public:
     CAnimationManager();
 
-    void                                          tick();
+    void                                          tick(CMonitor* pMonitor = nullptr);
+    void                                          tickMonitor(CMonitor* pMonitor);
     bool                                          shouldTickForNext();
     void                                          onTicked();
     void                                          scheduleTick();
+    void                                          scheduleTickForMonitor(CMonitor* pMonitor, bool frameScheduled = false);
+    void                                          scheduleTickForVariable(CAnimatedVariable* av);
     void                                          addBezierWithName(std::string, const Vector2D&, const Vector2D&);
     void                                          removeAllBeziers();
 
     void                                          onWindowPostCreateClose(CWindow*, bool close = false);
 
+    // av's lane, added if it has none, takes its current begun / goal / curve. Called when it (re)starts animating
+    void                                          updateLane(CAnimatedVariable* av);
+    void                                          removeLane(CAnimatedVariable* av);
+    // the beziers or animation configs changed, every variable re-resolves its curve
+    void                                          refreshBeziers();
+
     bool                                          bezierExists(const std::string&);
     CBezierCurve*                                 getBezier(const std::string&);
 
@@ -28,6 +135,9 @@ class CAnimationManager {
 
     std::unordered_map<std::string, CBezierCurve> getAllBeziers();
 
+    // the monitor av is drawn on, nullptr if it has no owner or the owner's monitor is gone
+    CMonitor*                                     getMonitorForVariable(CAnimatedVariable* av);
+
     std::vector<CAnimatedVariable*>               m_vAnimatedVariables;
     std::vector<CAnimatedVariable*>               m_vActiveAnimatedVariables;
 
@@ -47,6 +157,27 @@ class CAnimationManager {
 
     bool                                          m_bTickScheduled = false;
 
+    // the active variables, by type
+    SAnimationLanes<float, 1>        m_sFloatLanes;
+    SAnimationLanes<double, 2>       m_sVectorLanes;
+    SAnimationLanes<float, 4>        m_sColorLanes;
+
+    // per tick scratch, kept around for the allocations
+    std::vector<SAnimationTickEntry> m_vTickEntries;
+
+    wlr_box                          prepareDamage(CAnimatedVariable* av, CMonitor* pMonitor);
+
+    // the frame time snapshot of each monitor animated this tick
+    std::vector<std::pair<CMonitor*, std::chrono::steady_clock::time_point>> m_vTickFrameTimes;
+    // monitors with animations found by a tick of another one
+    std::vector<CMonitor*>                                                   m_vTickOtherMonitors;
+
+    // damaged this tick, decos are updated (and windows damaged) once for the final state after the pass
+    std::vector<CWindow*> m_vTickDamagedWindows;
+    std::vector<int>      m_vTickDamagedWorkspaces;
+    bool                  m_bTickFloatingDamaged = false;
+    std::chrono::steady_clock::time_point                                    getFrameTime(CMonitor* pMonitor, const std::chrono::steady_clock::time_point& now);
+
     // Anim stuff
     void animationPopin(CWindow*, bool close = false, float minPerc = 0.f);
     void animationSlide(CWindow*, std::string force = "", bool close = false);
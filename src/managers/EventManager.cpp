@@ -1,9 +1,11 @@
 #include "EventManager.hpp"
 #include "../Compositor.hpp"
+#include "../helpers/VarList.hpp"
 
 #include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,107 +20,208 @@
 
 CEventManager::CEventManager() {}
 
-int fdHandleWrite(int fd, uint32_t mask, void* data) {
-
-    auto removeFD = [&](int fd) -> void {
-        const auto ACCEPTEDFDS = (std::deque<std::pair<int, wl_event_source*>>*)data;
-        for (auto it = ACCEPTEDFDS->begin(); it != ACCEPTEDFDS->end();) {
-            if (it->first == fd) {
-                wl_event_source_remove(it->second); // remove this fd listener
-                it = ACCEPTEDFDS->erase(it);
-            } else {
-                it++;
-            }
-        }
-
-        close(fd);
-    };
+void CEventManager::startThread() {
+    const auto SOCKET = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
 
-    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
-        // remove, hanged up
-        removeFD(fd);
-        return 0;
+    if (SOCKET < 0) {
+        Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (1) IPC will not work.");
+        return;
     }
 
-    int availableBytes;
-    if (ioctl(fd, FIONREAD, &availableBytes) == -1) {
-        Debug::log(ERR, "fd {} sent invalid data (1)", fd);
-        removeFD(fd);
-        return 0;
+    if (pipe2(m_iWakeFDs, O_CLOEXEC | O_NONBLOCK) < 0) {
+        Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (2) IPC will not work.");
+        close(SOCKET);
+        return;
     }
 
-    char       buf[availableBytes];
-    const auto RECEIVED = recv(fd, buf, availableBytes, 0);
-    if (RECEIVED == -1) {
-        Debug::log(ERR, "fd {} sent invalid data (2)", fd);
-        removeFD(fd);
-        return 0;
+    sockaddr_un SERVERADDRESS = {.sun_family = AF_UNIX};
+    std::string socketPath    = "/tmp/hypr/" + g_pCompositor->m_szInstanceSignature + "/.socket2.sock";
+    strncpy(SERVERADDRESS.sun_path, socketPath.c_str(), sizeof(SERVERADDRESS.sun_path) - 1);
+
+    bind(SOCKET, (sockaddr*)&SERVERADDRESS, SUN_LEN(&SERVERADDRESS));
+
+    // 10 max queued.
+    listen(SOCKET, 10);
+
+    Debug::log(LOG, "Hypr socket 2 started at {}", socketPath);
+
+    // one persistent dispatcher owns all subscribers. postEvent only queues, this thread does all the (non-blocking) writes.
+    m_tThread = std::thread([this, SOCKET]() { dispatchThread(SOCKET); });
+
+    m_tThread.detach();
+}
+
+void CEventManager::wakeDispatcher() {
+    // one pending wakeup is enough, the dispatcher services every client when it wakes
+    if (m_bWakePending.exchange(true))
+        return;
+
+    const char BYTE = 0;
+    write(m_iWakeFDs[1], &BYTE, 1);
+}
+
+bool CEventManager::writeClient(SClient& client) {
+    while (!client.queue.empty()) {
+        const auto& EV      = client.queue.front();
+        const auto  WRITTEN = send(client.fd, EV.c_str() + client.headOffset, EV.length() - client.headOffset, MSG_NOSIGNAL);
+
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        client.headOffset += WRITTEN;
+
+        if (client.headOffset < EV.length())
+            continue;
+
+        client.headOffset = 0;
+        client.queue.pop_front();
     }
 
-    return 0;
+    return true;
 }
 
-void CEventManager::startThread() {
-    m_tThread = std::thread([&]() {
-        const auto SOCKET = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+void CEventManager::dispatchThread(int listenFD) {
+    std::vector<pollfd> pollFDs;
 
-        if (SOCKET < 0) {
-            Debug::log(ERR, "Couldn't start the Hyprland Socket 2. (1) IPC will not work.");
-            return;
+    while (1) {
+        pollFDs.clear();
+        pollFDs.push_back({.fd = m_iWakeFDs[0], .events = POLLIN});
+        pollFDs.push_back({.fd = listenFD, .events = POLLIN});
+
+        {
+            std::lock_guard<std::mutex> lg(m_mClientsMutex);
+            for (auto& c : m_dClients) {
+                pollFDs.push_back({.fd = c.fd, .events = (short)(POLLIN | (c.queue.empty() ? 0 : POLLOUT))});
+            }
+        }
+
+        if (poll(pollFDs.data(), pollFDs.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+
+            Debug::log(ERR, "Socket 2 poll failed with {}, events will stop", errno);
+            break;
+        }
+
+        if (pollFDs[0].revents & POLLIN) {
+            char buf[64];
+            while (read(m_iWakeFDs[0], buf, sizeof(buf)) > 0) {
+                ;
+            }
+
+            // only after draining, otherwise a wakeup between the two could get lost
+            m_bWakePending = false;
         }
 
-        sockaddr_un SERVERADDRESS = {.sun_family = AF_UNIX};
-        std::string socketPath    = "/tmp/hypr/" + g_pCompositor->m_szInstanceSignature + "/.socket2.sock";
-        strncpy(SERVERADDRESS.sun_path, socketPath.c_str(), sizeof(SERVERADDRESS.sun_path) - 1);
+        std::lock_guard<std::mutex> lg(m_mClientsMutex);
 
-        bind(SOCKET, (sockaddr*)&SERVERADDRESS, SUN_LEN(&SERVERADDRESS));
+        // the only thing subscribers send us are filter requests, one per line
+        std::vector<int> toRemove;
+        for (size_t i = 2; i < pollFDs.size(); ++i) {
+            const auto& PFD    = pollFDs[i];
+            auto&       client = m_dClients[i - 2]; // only this thread adds or removes clients, so the order still matches
 
-        // 10 max queued.
-        listen(SOCKET, 10);
+            if (PFD.revents & (POLLERR | POLLNVAL)) {
+                toRemove.push_back(PFD.fd);
+                continue;
+            }
 
-        sockaddr_in clientAddress;
-        socklen_t   clientSize = sizeof(clientAddress);
+            if (PFD.revents & (POLLIN | POLLHUP)) {
+                char       buf[1024];
+                const auto RECEIVED = recv(PFD.fd, buf, sizeof(buf), 0);
+                if (RECEIVED == 0 || (RECEIVED < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    toRemove.push_back(PFD.fd);
+                    continue;
+                }
+
+                if (RECEIVED <= 0)
+                    continue;
+
+                client.readBuffer.append(buf, RECEIVED);
+
+                size_t newline = 0;
+                while ((newline = client.readBuffer.find('\n')) != std::string::npos) {
+                    handleClientRequest(client, client.readBuffer.substr(0, newline));
+                    client.readBuffer.erase(0, newline + 1);
+                }
+
+                if (client.readBuffer.length() > 4096) {
+                    Debug::log(ERR, "Socket 2 client at FD {} sent a request without a newline, disconnecting", client.fd);
+                    toRemove.push_back(PFD.fd);
+                }
+            }
+        }
 
-        Debug::log(LOG, "Hypr socket 2 started at {}", socketPath);
+        for (auto& c : m_dClients) {
+            if (c.overflowed || !writeClient(c))
+                toRemove.push_back(c.fd);
+        }
+
+        if (!toRemove.empty()) {
+            std::erase_if(m_dClients, [&](const auto& c) {
+                if (std::find(toRemove.begin(), toRemove.end(), c.fd) == toRemove.end())
+                    return false;
 
-        while (1) {
-            const auto ACCEPTEDCONNECTION = accept4(SOCKET, (sockaddr*)&clientAddress, &clientSize, SOCK_CLOEXEC);
+                Debug::log(LOG, "Socket 2 client at FD {} disconnected", c.fd);
+                close(c.fd);
+                return true;
+            });
+        }
 
-            if (ACCEPTEDCONNECTION > 0) {
-                // new connection!
+        if (pollFDs[1].revents & POLLIN) {
+            while (1) {
+                const auto ACCEPTEDCONNECTION = accept4(listenFD, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
 
-                int flagsNew = fcntl(ACCEPTEDCONNECTION, F_GETFL, 0);
-                fcntl(ACCEPTEDCONNECTION, F_SETFL, flagsNew | O_NONBLOCK);
+                if (ACCEPTEDCONNECTION < 0)
+                    break;
 
                 Debug::log(LOG, "Socket 2 accepted a new client at FD {}", ACCEPTEDCONNECTION);
 
-                // add to event loop so we can close it when we need to
-                m_dAcceptedSocketFDs.push_back(
-                    {ACCEPTEDCONNECTION, wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, ACCEPTEDCONNECTION, WL_EVENT_READABLE, fdHandleWrite, &m_dAcceptedSocketFDs)});
+                m_dClients.push_back({.fd = ACCEPTEDCONNECTION});
             }
         }
+    }
 
-        close(SOCKET);
-    });
+    close(listenFD);
+}
 
-    m_tThread.detach();
+bool CEventManager::SClient::wants(const SHyprIPCEvent& event) const {
+    if (!events.empty() && !events.contains(event.event))
+        return false;
+
+    // events that aren't about a specific monitor always pass a monitor filter. Those are the global ones (activelayout, submap,
+    // lockgroups, ignoregrouplock, screencast) and activewindow / activewindowv2 with nothing focused.
+    if (!monitor.empty() && !event.monitor.empty() && event.monitor != monitor)
+        return false;
+
+    return true;
 }
 
-void CEventManager::flushEvents() {
-    eventQueueMutex.lock();
+void CEventManager::handleClientRequest(SClient& client, const std::string& request) {
+    // subscribe ev1,ev2,...  -> only receive these events, "subscribe all" to reset
+    // monitor NAME           -> drop monitor-specific events for other monitors, "monitor all" to reset
+    const auto SPACEPOS = request.find_first_of(' ');
+    const auto COMMAND  = removeBeginEndSpacesTabs(request.substr(0, SPACEPOS));
+    const auto ARG      = SPACEPOS == std::string::npos ? std::string{""} : removeBeginEndSpacesTabs(request.substr(SPACEPOS + 1));
 
-    for (auto& ev : m_dQueuedEvents) {
-        std::string eventString = (ev.event + ">>" + ev.data).substr(0, 1022) + "\n";
-        for (auto& fd : m_dAcceptedSocketFDs) {
-            try {
-                write(fd.first, eventString.c_str(), eventString.length());
-            } catch (...) {}
-        }
-    }
+    if (COMMAND == "subscribe") {
+        client.events.clear();
 
-    m_dQueuedEvents.clear();
+        if (ARG.empty() || ARG == "all")
+            return;
 
-    eventQueueMutex.unlock();
+        CVarList events(ARG, 0, ',', true);
+        for (auto& e : events) {
+            client.events.insert(e);
+        }
+    } else if (COMMAND == "monitor") {
+        client.monitor = ARG == "all" ? "" : ARG;
+    } else if (!COMMAND.empty())
+        Debug::log(WARN, "Socket 2 client at FD {} sent an unknown request \"{}\"", client.fd, COMMAND);
 }
 
 void CEventManager::postEvent(const SHyprIPCEvent event) {
@@ -128,14 +231,55 @@ void CEventManager::postEvent(const SHyprIPCEvent event) {
         return;
     }
 
-    std::thread(
-        [&](const SHyprIPCEvent ev) {
-            eventQueueMutex.lock();
-            m_dQueuedEvents.push_back(ev);
-            eventQueueMutex.unlock();
+    static auto* const PQUEUESIZE = &g_pConfigManager->getConfigValuePtr("misc:socket2_queue_size")->intValue;
+    static auto* const POVERFLOW  = &g_pConfigManager->getConfigValuePtr("misc:socket2_overflow_policy")->intValue;
+
+    std::string        eventString = ""; // formatted lazily, nobody might be interested
+    bool               needsWake   = false;
+
+    {
+        std::lock_guard<std::mutex> lg(m_mClientsMutex);
+
+        m_sStats.postedEvents++;
+
+        for (auto& c : m_dClients) {
+            if (c.overflowed || !c.wants(event))
+                continue;
+
+            if ((int64_t)c.queue.size() >= std::max(*PQUEUESIZE, (int64_t)1)) {
+                if (*POVERFLOW == EVENT_OVERFLOW_DISCONNECT) {
+                    Debug::log(WARN, "Socket 2 client at FD {} fell {} events behind, disconnecting", c.fd, c.queue.size());
+                    c.overflowed = true;
+                    m_sStats.disconnects++;
+                    needsWake = true;
+                } else
+                    m_sStats.droppedEvents++;
+
+                continue;
+            }
+
+            if (eventString.empty())
+                eventString = (event.event + ">>" + event.data).substr(0, 1022) + "\n";
+
+            c.queue.push_back(eventString);
+            needsWake = true;
+        }
+    }
+
+    if (needsWake)
+        wakeDispatcher();
+}
+
+SEventSocketStats CEventManager::getStats() {
+    std::lock_guard<std::mutex> lg(m_mClientsMutex);
+
+    SEventSocketStats           stats = m_sStats;
+    stats.clients                     = m_dClients.size();
+
+    for (auto& c : m_dClients) {
+        stats.queuedEvents += c.queue.size();
+        stats.maxQueueDepth = std::max(stats.maxQueueDepth, c.queue.size());
+    }
 
-            flushEvents();
-        },
-        event)
-        .detach();
+    return stats;
 }
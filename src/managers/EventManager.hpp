@@ -2,6 +2,8 @@
 #include <deque>
 #include <fstream>
 #include <mutex>
+#include <atomic>
+#include <unordered_set>
 
 #include "../defines.hpp"
 #include "../helpers/MiscFunctions.hpp"
@@ -9,24 +11,62 @@
 struct SHyprIPCEvent {
     std::string event;
     std::string data;
+    std::string monitor = ""; // the monitor this event is about (a window's / workspace's / layer's), if any. Used for subscription filters, not sent.
+};
+
+enum eEventOverflowPolicy {
+    EVENT_OVERFLOW_DROP = 0,
+    EVENT_OVERFLOW_DISCONNECT
+};
+
+struct SEventSocketStats {
+    size_t   clients       = 0;
+    size_t   queuedEvents  = 0; // across all clients
+    size_t   maxQueueDepth = 0; // deepest single client queue right now
+    uint64_t postedEvents  = 0;
+    uint64_t droppedEvents = 0;
+    uint64_t disconnects   = 0; // clients kicked for overflowing
 };
 
 class CEventManager {
   public:
     CEventManager();
 
-    void        postEvent(const SHyprIPCEvent event);
+    void              postEvent(const SHyprIPCEvent event);
+
+    void              startThread();
 
-    void        startThread();
+    SEventSocketStats getStats();
+
+    std::thread       m_tThread;
 
-    std::thread m_tThread;
   private:
-    void                                         flushEvents();
+    struct SClient {
+        int                             fd = -1;
+        std::deque<std::string>         queue;
+        size_t                          headOffset = 0; // bytes of queue.front() already sent
+        bool                            overflowed = false;
+
+        // subscription filter, empty means everything
+        std::unordered_set<std::string> events;
+        std::string                     monitor = "";
+        std::string                     readBuffer;
+
+        bool                            wants(const SHyprIPCEvent& event) const;
+    };
+
+    void                dispatchThread(int listenFD);
+    void                wakeDispatcher();
+    bool                writeClient(SClient& client);
+    void                handleClientRequest(SClient& client, const std::string& request);
+
+    std::mutex          m_mClientsMutex;
+    std::deque<SClient> m_dClients;
 
-    std::mutex                                   eventQueueMutex;
-    std::deque<SHyprIPCEvent>                    m_dQueuedEvents;
+    SEventSocketStats   m_sStats;
 
-    std::deque<std::pair<int, wl_event_source*>> m_dAcceptedSocketFDs;
+    int                 m_iWakeFDs[2]  = {-1, -1};
+    std::atomic<bool>   m_bWakePending = false;
 };
 
 inline std::unique_ptr<CEventManager> g_pEventManager;
@@ -87,7 +87,8 @@ CKeybindManager::CKeybindManager() {
 void CKeybindManager::addKeybind(SKeybind kb) {
     m_lKeybinds.push_back(kb);
 
-    m_pActiveKeybind = nullptr;
+    m_pActiveKeybind     = nullptr;
+    m_bKeybindIndexDirty = true;
 }
 
 void CKeybindManager::removeKeybind(uint32_t mod, const std::string& key) {
@@ -96,12 +97,14 @@ void CKeybindManager::removeKeybind(uint32_t mod, const std::string& key) {
             const auto KEYNUM = std::stoi(key);
 
             if (it->modmask == mod && it->keycode == KEYNUM) {
+                std::erase(m_vPressedSpecialBinds, &*it);
                 it = m_lKeybinds.erase(it);
 
                 if (it == m_lKeybinds.end())
                     break;
             }
         } else if (it->modmask == mod && it->key == key) {
+            std::erase(m_vPressedSpecialBinds, &*it);
             it = m_lKeybinds.erase(it);
 
             if (it == m_lKeybinds.end())
@@ -109,7 +112,50 @@ void CKeybindManager::removeKeybind(uint32_t mod, const std::string& key) {
         }
     }
 
-    m_pActiveKeybind = nullptr;
+    m_pActiveKeybind     = nullptr;
+    m_bKeybindIndexDirty = true;
+}
+
+void CKeybindManager::invalidateKeybindIndex() {
+    m_bKeybindIndexDirty = true;
+}
+
+static uint64_t bindIndexKey(uint32_t modmask, uint32_t trigger) {
+    return ((uint64_t)modmask << 32) | trigger;
+}
+
+void CKeybindManager::updateKeybindIndex() {
+    if (!m_bKeybindIndexDirty)
+        return;
+
+    m_bKeybindIndexDirty = false;
+    m_mKeybindIndex.clear();
+
+    size_t order = 0;
+
+    for (auto& k : m_lKeybinds) {
+        k.order = order++;
+
+        // resolved for every bind, shadowing compares keycode binds' names too
+        k.keysym      = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+        k.keysymUpper = xkb_keysym_to_upper(k.keysym);
+
+        const auto DISPATCHER = m_mDispatchers.find(k.mouse ? "mouse" : k.handler);
+        k.dispatcher          = DISPATCHER == m_mDispatchers.end() ? nullptr : &DISPATCHER->second;
+
+        auto& index = m_mKeybindIndex[k.submap];
+
+        index.byKey[k.key].push_back(&k);
+
+        if (k.keycode != -1)
+            index.byKeycode[bindIndexKey(k.modmask, k.keycode)].push_back(&k);
+        else if (k.keysym != XKB_KEY_NoSymbol) {
+            index.byKeysym[bindIndexKey(k.modmask, k.keysym)].push_back(&k);
+
+            if (k.keysymUpper != k.keysym)
+                index.byKeysym[bindIndexKey(k.modmask, k.keysymUpper)].push_back(&k);
+        }
+    }
 }
 
 uint32_t CKeybindManager::stringToModMask(std::string mods) {
@@ -428,7 +474,32 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const std::string&
     if (g_pCompositor->m_sSeat.exclusiveClient)
         Debug::log(LOG, "Keybind handling only locked (inhibitor)");
 
-    for (auto& k : m_lKeybinds) {
+    updateKeybindIndex();
+
+    // only binds of the current submap with this trigger (and mods) can match, plus held pass / global / mouse binds which are released regardless.
+    // The checks below are still done in full, in config order.
+    std::vector<SKeybind*> candidates = m_vPressedSpecialBinds;
+
+    if (const auto IT = m_mKeybindIndex.find(m_szCurrentSelectedSubmap); IT != m_mKeybindIndex.end()) {
+        const auto append = [&](const auto& map, const auto& trigger) {
+            if (const auto BINDS = map.find(trigger); BINDS != map.end())
+                candidates.insert(candidates.end(), BINDS->second.begin(), BINDS->second.end());
+        };
+
+        if (!key.empty())
+            append(IT->second.byKey, key);
+        else {
+            append(IT->second.byKeycode, bindIndexKey(modmask, keycode));
+            if (keysym != 0)
+                append(IT->second.byKeysym, bindIndexKey(modmask, keysym));
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a->order < b->order; });
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (auto& pk : candidates) {
+        auto&      k                 = *pk;
         const bool SPECIALDISPATCHER = k.handler == "global" || k.handler == "pass" || k.handler == "mouse";
         const bool SPECIALTRIGGERED =
             std::find_if(m_vPressedSpecialBinds.begin(), m_vPressedSpecialBinds.end(), [&](const auto& other) { return other == &k; }) != m_vPressedSpecialBinds.end();
@@ -448,12 +519,7 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const std::string&
             if (keysym == 0)
                 continue; // this is a keycode check run
 
-            // oMg such performance hit!!11!
-            // this little maneouver is gonna cost us 4µs
-            const auto KBKEY      = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
-            const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
-
-            if (keysym != KBKEY && keysym != KBKEYUPPER)
+            if (keysym != k.keysym && keysym != k.keysymUpper)
                 continue;
         }
 
@@ -473,7 +539,7 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const std::string&
             continue;
         }
 
-        const auto DISPATCHER = m_mDispatchers.find(k.mouse ? "mouse" : k.handler);
+        const auto DISPATCHER = k.dispatcher;
 
         if (SPECIALTRIGGERED && !pressed)
             std::erase_if(m_vPressedSpecialBinds, [&](const auto& other) { return other == &k; });
@@ -481,7 +547,7 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const std::string&
             m_vPressedSpecialBinds.push_back(&k);
 
         // Should never happen, as we check in the ConfigManager, but oh well
-        if (DISPATCHER == m_mDispatchers.end()) {
+        if (!DISPATCHER) {
             Debug::log(ERR, "Invalid handler in a keybind! (handler {} does not exist)", k.handler);
         } else {
             // call the dispatcher
@@ -490,9 +556,9 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const std::string&
             m_iPassPressed = (int)pressed;
 
             if (k.handler == "mouse")
-                DISPATCHER->second((pressed ? "1" : "0") + k.arg);
+                (*DISPATCHER)((pressed ? "1" : "0") + k.arg);
             else
-                DISPATCHER->second(k.arg);
+                (*DISPATCHER)(k.arg);
 
             m_iPassPressed = -1;
 
@@ -521,6 +587,8 @@ bool CKeybindManager::handleKeybinds(const uint32_t& modmask, const std::string&
 void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const int& doesntHaveCode) {
     // shadow disables keybinds after one has been triggered
 
+    updateKeybindIndex();
+
     for (auto& k : m_lKeybinds) {
 
         bool shadow = false;
@@ -528,11 +596,8 @@ void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const int&
         if (k.handler == "global" || k.transparent)
             continue; // can't be shadowed
 
-        const auto KBKEY      = xkb_keysym_from_name(k.key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
-        const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
-
         for (auto& pk : m_dPressedKeysyms) {
-            if ((pk == KBKEY || pk == KBKEYUPPER)) {
+            if ((pk == k.keysym || pk == k.keysymUpper)) {
                 shadow = true;
 
                 if (pk == doesntHave && doesntHave != 0) {
@@ -727,6 +792,9 @@ void CKeybindManager::kill(std::string args) {
 
 void CKeybindManager::clearKeybinds() {
     m_lKeybinds.clear();
+    m_vPressedSpecialBinds.clear();
+
+    m_bKeybindIndexDirty = true;
 }
 
 void CKeybindManager::toggleActiveFloating(std::string args) {
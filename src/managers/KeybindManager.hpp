@@ -26,6 +26,19 @@ struct SKeybind {
 
     // DO NOT INITIALIZE
     bool shadowed = false;
+
+    // resolved when the bind index is built, DO NOT INITIALIZE
+    xkb_keysym_t                      keysym      = 0;
+    xkb_keysym_t                      keysymUpper = 0;
+    std::function<void(std::string)>* dispatcher  = nullptr;
+    size_t                            order       = 0;
+};
+
+// binds of one submap by their trigger
+struct SKeybindIndex {
+    std::unordered_map<uint64_t, std::vector<SKeybind*>>    byKeysym;  // modmask << 32 | keysym, both cases
+    std::unordered_map<uint64_t, std::vector<SKeybind*>>    byKeycode; // modmask << 32 | keycode
+    std::unordered_map<std::string, std::vector<SKeybind*>> byKey;     // key name (mouse:, switch:, ...), any mods
 };
 
 enum eFocusWindowMode {
@@ -52,6 +65,7 @@ class CKeybindManager {
     uint32_t                                                          stringToModMask(std::string);
     void                                                              clearKeybinds();
     void                                                              shadowKeybinds(const xkb_keysym_t& doesntHave = 0, const int& doesntHaveCode = 0);
+    void                                                              invalidateKeybindIndex();
 
     std::unordered_map<std::string, std::function<void(std::string)>> m_mDispatchers;
 
@@ -95,6 +109,11 @@ class CKeybindManager {
     static void               moveWindowIntoGroup(CWindow* pWindow, CWindow* pWindowInDirection);
     static void               switchToWindow(CWindow* PWINDOWTOCHANGETO);
 
+    // by submap, rebuilt lazily after binds or dispatchers change
+    std::unordered_map<std::string, SKeybindIndex> m_mKeybindIndex;
+    bool                                           m_bKeybindIndexDirty = true;
+    void                                           updateKeybindIndex();
+
     // -------------- Dispatchers -------------- //
     static void     killActive(std::string);
     static void     kill(std::string);
@@ -7,6 +7,7 @@ void CInputManager::onMouseMoved(wlr_pointer_motion_event* e) {
     static auto* const PSENS      = &g_pConfigManager->getConfigValuePtr("general:sensitivity")->floatValue;
     static auto* const PNOACCEL   = &g_pConfigManager->getConfigValuePtr("input:force_no_accel")->intValue;
     static auto* const PSENSTORAW = &g_pConfigManager->getConfigValuePtr("general:apply_sens_to_raw")->intValue;
+    static auto* const PCOALESCE  = &g_pConfigManager->getConfigValuePtr("input:motion_coalescing")->intValue;
 
     const auto         DELTA = *PNOACCEL == 1 ? Vector2D(e->unaccel_dx, e->unaccel_dy) : Vector2D(e->delta_x, e->delta_y);
 
@@ -19,14 +20,95 @@ void CInputManager::onMouseMoved(wlr_pointer_motion_event* e) {
 
     wlr_cursor_move(g_pCompositor->m_sWLRCursor, &e->pointer->base, DELTA.x * *PSENS, DELTA.y * *PSENS);
 
-    mouseMoveUnified(e->time_msec);
+    m_sMotionStats.received++;
+
+    // relative motion and the cursor itself are never delayed, only the focus / hit-test pass is.
+    // Constrained pointers aren't coalesced, the lock / confine in mouseMoveUnified has to catch every event before a client sees the cursor outside.
+    if (*PCOALESCE && !(g_pCompositor->m_sSeat.mouse && g_pCompositor->m_sSeat.mouse->currentConstraint))
+        queueCoalescedMotion(e->time_msec);
+    else if (m_bMotionPending) {
+        m_uPendingMotionTime = e->time_msec;
+        flushCoalescedMotion();
+    } else {
+        m_sMotionStats.processed++;
+        mouseMoveUnified(e->time_msec);
+    }
 
     m_tmrLastCursorMovement.reset();
 
     m_bLastInputTouch = false;
 }
 
+static int handleMotionCoalescingTimer(void* data) {
+    g_pInputManager->flushCoalescedMotion();
+
+    return 0;
+}
+
+void CInputManager::queueCoalescedMotion(uint32_t time) {
+    static auto* const PCOALESCERATE = &g_pConfigManager->getConfigValuePtr("input:motion_coalescing_rate")->intValue;
+
+    m_uPendingMotionTime = time;
+
+    if (m_bMotionPending) {
+        m_sMotionStats.coalesced++;
+        return;
+    }
+
+    m_bMotionPending = true;
+
+    if (!m_pMotionTimer)
+        m_pMotionTimer = wl_event_loop_add_timer(g_pCompositor->m_sWLEventLoop, handleMotionCoalescingTimer, nullptr);
+
+    if (*PCOALESCERATE > 0) {
+        // fixed rate: run right away if the last pass is old enough, otherwise at the end of the interval
+        const int   INTERVAL = std::max(1000 / *PCOALESCERATE, 1);
+        const float ELAPSED  = m_tmrLastMotionFlush.getSeconds() * 1000.f;
+
+        if (ELAPSED >= INTERVAL)
+            flushCoalescedMotion();
+        else
+            wl_event_source_timer_update(m_pMotionTimer, std::max((int)(INTERVAL - ELAPSED), 1));
+
+        return;
+    }
+
+    // frame aligned: the next frame of any monitor runs the pass. Nothing renders with dpms off, so don't wait on it.
+    const auto PMONITOR = g_pCompositor->getMonitorFromCursor();
+
+    if (!PMONITOR || !PMONITOR->m_bEnabled || !g_pCompositor->m_bDPMSStateON) {
+        flushCoalescedMotion();
+        return;
+    }
+
+    g_pCompositor->scheduleFrameForMonitor(PMONITOR);
+
+    // in case the frame never comes (session switch, output going away)
+    wl_event_source_timer_update(m_pMotionTimer, 100);
+}
+
+void CInputManager::flushCoalescedMotion() {
+    if (!m_bMotionPending)
+        return;
+
+    m_bMotionPending = false;
+
+    if (m_pMotionTimer)
+        wl_event_source_timer_update(m_pMotionTimer, 0);
+
+    m_tmrLastMotionFlush.reset();
+    m_sMotionStats.processed++;
+
+    mouseMoveUnified(m_uPendingMotionTime);
+}
+
+SMotionCoalescingStats CInputManager::getMotionCoalescingStats() {
+    return m_sMotionStats;
+}
+
 void CInputManager::onMouseWarp(wlr_pointer_motion_absolute_event* e) {
+    flushCoalescedMotion();
+
     wlr_cursor_warp_absolute(g_pCompositor->m_sWLRCursor, &e->pointer->base, e->x, e->y);
 
     mouseMoveUnified(e->time_msec);
@@ -37,6 +119,8 @@ void CInputManager::onMouseWarp(wlr_pointer_motion_absolute_event* e) {
 }
 
 void CInputManager::simulateMouseMovement() {
+    flushCoalescedMotion();
+
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
     m_vLastCursorPosFloored = m_vLastCursorPosFloored - Vector2D(1, 1); // hack: force the mouseMoveUnified to report without making this a refocus.
@@ -424,6 +508,8 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus) {
 }
 
 void CInputManager::onMouseButton(wlr_pointer_button_event* e) {
+    flushCoalescedMotion(); // the button has to land on what's under the cursor now
+
     g_pCompositor->notifyIdleActivity();
 
     EMIT_HOOK_EVENT("mouseButton", e);
@@ -623,6 +709,8 @@ void CInputManager::onMouseWheel(wlr_pointer_axis_event* e) {
     static auto* const PSCROLLFACTOR      = &g_pConfigManager->getConfigValuePtr("input:touchpad:scroll_factor")->floatValue;
     static auto* const PGROUPBARSCROLLING = &g_pConfigManager->getConfigValuePtr("misc:groupbar_scrolling")->intValue;
 
+    flushCoalescedMotion();
+
     auto               factor = (*PSCROLLFACTOR <= 0.f || e->source != WLR_AXIS_SOURCE_FINGER ? 1.f : *PSCROLLFACTOR);
 
     bool               passEvent = g_pKeybindManager->onAxisEvent(e);
@@ -1089,6 +1177,8 @@ void CInputManager::onKeyboardKey(wlr_keyboard_key_event* e, SKeyboard* pKeyboar
     if (!pKeyboard->enabled)
         return;
 
+    flushCoalescedMotion(); // follow_mouse focus has to be current before the key is routed
+
     static auto* const PDPMS = &g_pConfigManager->getConfigValuePtr("misc:key_press_enables_dpms")->intValue;
     if (*PDPMS && !g_pCompositor->m_bDPMSStateON) {
         // enable dpms
@@ -35,6 +35,12 @@ enum eBorderIconDirection
     BORDERICON_DOWN_RIGHT,
 };
 
+struct SMotionCoalescingStats {
+    uint64_t received  = 0; // relative motion events
+    uint64_t processed = 0; // full motion passes (refocus, hit-testing, seat notify) they resulted in
+    uint64_t coalesced = 0; // events folded into an already pending pass
+};
+
 struct STouchData {
     CWindow*       touchFocusWindow  = nullptr;
     SLayerSurface* touchFocusLS      = nullptr;
@@ -187,6 +193,10 @@ class CInputManager {
     CWindow*     m_pLastMouseFocus   = nullptr;
     wlr_surface* m_pLastMouseSurface = nullptr;
 
+    // runs the pending coalesced motion pass, if any. Called on monitor frames and before other pointer / key / touch / tablet input.
+    void                   flushCoalescedMotion();
+    SMotionCoalescingStats getMotionCoalescingStats();
+
   private:
     bool                 m_bCursorImageOverridden = false;
     eBorderIconDirection m_eBorderIconDirection   = BORDERICON_NONE;
@@ -211,6 +221,14 @@ class CInputManager {
 
     void               applyConfigToKeyboard(SKeyboard*);
 
+    // input:motion_coalescing
+    void                   queueCoalescedMotion(uint32_t time);
+    bool                   m_bMotionPending     = false;
+    uint32_t               m_uPendingMotionTime = 0;
+    wl_event_source*       m_pMotionTimer       = nullptr;
+    CTimer                 m_tmrLastMotionFlush;
+    SMotionCoalescingStats m_sMotionStats;
+
     // this will be set after a refocus()
     wlr_surface*   m_pFoundSurfaceToFocus = nullptr;
     SLayerSurface* m_pFoundLSToFocus      = nullptr;
@@ -33,6 +33,8 @@ void CInputManager::newTabletTool(wlr_input_device* pDevice) {
     PNEWTABLET->hyprListener_Axis.initCallback(
         &wlr_tablet_from_input_device(pDevice)->events.axis,
         [](void* owner, void* data) {
+            g_pInputManager->flushCoalescedMotion();
+
             const auto EVENT = (wlr_tablet_tool_axis_event*)data;
             const auto PTAB  = (STablet*)owner;
 
@@ -89,6 +91,8 @@ void CInputManager::newTabletTool(wlr_input_device* pDevice) {
     PNEWTABLET->hyprListener_Tip.initCallback(
         &wlr_tablet_from_input_device(pDevice)->events.tip,
         [](void* owner, void* data) {
+            g_pInputManager->flushCoalescedMotion();
+
             const auto EVENT = (wlr_tablet_tool_tip_event*)data;
             const auto PTAB  = (STablet*)owner;
 
@@ -108,6 +112,8 @@ void CInputManager::newTabletTool(wlr_input_device* pDevice) {
     PNEWTABLET->hyprListener_Button.initCallback(
         &wlr_tablet_from_input_device(pDevice)->events.button,
         [](void* owner, void* data) {
+            g_pInputManager->flushCoalescedMotion();
+
             const auto EVENT = (wlr_tablet_tool_button_event*)data;
 
             const auto PTOOL = g_pInputManager->ensureTabletToolPresent(EVENT->tool);
@@ -119,6 +125,8 @@ void CInputManager::newTabletTool(wlr_input_device* pDevice) {
     PNEWTABLET->hyprListener_Proximity.initCallback(
         &wlr_tablet_from_input_device(pDevice)->events.proximity,
         [](void* owner, void* data) {
+            g_pInputManager->flushCoalescedMotion();
+
             const auto EVENT = (wlr_tablet_tool_proximity_event*)data;
             const auto PTAB  = (STablet*)owner;
 
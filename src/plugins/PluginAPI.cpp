@@ -187,6 +187,7 @@ APICALL bool HyprlandAPI::addDispatcher(HANDLE handle, const std::string& name,
     PLUGIN->registeredDispatchers.push_back(name);
 
     g_pKeybindManager->m_mDispatchers[name] = handler;
+    g_pKeybindManager->invalidateKeybindIndex();
 
     return true;
 }
@@ -198,6 +199,7 @@ APICALL bool HyprlandAPI::removeDispatcher(HANDLE handle, const std::string& nam
         return false;
 
     std::erase_if(g_pKeybindManager->m_mDispatchers, [&](const auto& other) { return other.first == name; });
+    g_pKeybindManager->invalidateKeybindIndex();
     std::erase_if(PLUGIN->registeredDispatchers, [&](const auto& other) { return other == name; });
 
     return true;
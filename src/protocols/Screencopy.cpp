@@ -7,6 +7,12 @@
 
 #define SCREENCOPY_VERSION 3
 
+// how many commits back a client's buffer can be brought up to date from damage alone, older ones get a full copy
+constexpr size_t MAXBUFFERAGE = 16;
+
+// past this many rects a copy covers the damage extents in one go instead
+constexpr size_t MAXDAMAGERECTS = 32;
+
 static void bindManagerInt(wl_client* client, void* data, uint32_t version, uint32_t id) {
     g_pProtocolManager->m_pScreencopyProtocolManager->bindManager(client, data, version, id);
 }
@@ -175,6 +181,7 @@ void CScreencopyProtocolManager::removeFrame(SScreencopyFrame* frame, bool force
         return;
 
     std::erase_if(m_vFramesAwaitingWrite, [&](const auto& other) { return other == frame; });
+    g_pHyprOpenGL->m_sPixelReadback.cancel(frame);
 
     wl_resource_set_user_data(frame->resource, nullptr);
     if (frame->buffer && frame->buffer->n_locks > 0)
@@ -312,7 +319,8 @@ void CScreencopyProtocolManager::copyFrame(wl_client* client, wl_resource* resou
         return;
     }
 
-    PFRAME->buffer = PBUFFER;
+    PFRAME->buffer         = PBUFFER;
+    PFRAME->bufferResource = buffer;
 
     m_vFramesAwaitingWrite.emplace_back(PFRAME);
 
@@ -325,16 +333,113 @@ void CScreencopyProtocolManager::copyFrame(wl_client* client, wl_resource* resou
 }
 
 void CScreencopyProtocolManager::onOutputCommit(CMonitor* pMonitor, wlr_output_event_commit* e) {
+    recordCommitDamage(pMonitor, e);
+
     m_pLastMonitorBackBuffer = e->buffer;
     shareAllFrames(pMonitor);
     m_pLastMonitorBackBuffer = nullptr;
 }
 
+void CScreencopyProtocolManager::recordCommitDamage(CMonitor* pMonitor, wlr_output_event_commit* e) {
+    auto&          history = m_mDamageHistory[pMonitor];
+    const Vector2D SIZE    = {e->buffer->width, e->buffer->height};
+
+    history.seq++;
+
+    // without clients there is nobody to keep it for, and after a mode change the old damage means nothing.
+    // Either way, buffers filled before this commit need a full copy.
+    if (m_lClients.empty() || SIZE != history.size) {
+        history.damage.clear();
+        history.size = SIZE;
+        return;
+    }
+
+    // lastFrameDamage is whatever the renderer redrew for this commit, in transformed monitor coordinates
+    CRegion damage;
+    wlr_region_transform(damage.pixman(), pMonitor->lastFrameDamage.pixman(), wlr_output_transform_invert(pMonitor->output->transform), (int)pMonitor->vecTransformedSize.x,
+                         (int)pMonitor->vecTransformedSize.y);
+    history.damage.emplace_back(damage.intersect(0, 0, SIZE.x, SIZE.y));
+
+    if (history.damage.size() > MAXBUFFERAGE)
+        history.damage.pop_front();
+}
+
+CRegion CScreencopyProtocolManager::getFrameDamage(SScreencopyFrame* frame) {
+    CRegion full{0, 0, frame->box.width, frame->box.height};
+    CRegion damage{full};
+
+    auto&   bufferAges = frame->client->bufferAges;
+    std::erase_if(bufferAges, [](const auto& other) { return !other.buffer; });
+
+    auto age = std::find_if(bufferAges.begin(), bufferAges.end(), [&](const auto& other) { return other.buffer == frame->buffer; });
+
+    if (age == bufferAges.end()) {
+        if (bufferAges.size() >= MAXBUFFERAGE)
+            bufferAges.pop_front();
+
+        age         = bufferAges.emplace(bufferAges.end());
+        age->buffer = frame->buffer;
+        age->hyprListener_destroy.initCallback(
+            &frame->buffer->events.destroy,
+            [](void* owner, void* data) {
+                const auto PAGE = (SScreencopyBufferAge*)owner;
+                PAGE->buffer    = nullptr;
+                PAGE->hyprListener_destroy.removeCallback();
+            },
+            &*age, "Screencopy");
+    } else if (frame->withDamage && age->pMonitor == frame->pMonitor && wlr_box_equal(&age->box, &frame->box)) {
+        // the buffer holds commit age->seq, so it's missing the damage of every commit after that
+        const auto& HISTORY = m_mDamageHistory[frame->pMonitor];
+        const auto  MISSED  = HISTORY.seq - age->seq;
+
+        if (MISSED <= HISTORY.damage.size()) {
+            damage.clear();
+
+            for (size_t i = HISTORY.damage.size() - MISSED; i < HISTORY.damage.size(); ++i) {
+                damage.add(HISTORY.damage[i]);
+            }
+
+            damage.translate({-frame->box.x, -frame->box.y}).intersect(full);
+        }
+    }
+
+    age->pMonitor = frame->pMonitor;
+    age->box      = frame->box;
+    age->seq      = m_mDamageHistory[frame->pMonitor].seq;
+
+    return damage;
+}
+
+void CScreencopyProtocolManager::onMonitorRemoved(CMonitor* pMonitor) {
+    // a monitor coming back (or a new one at the same address) starts its history from scratch, ages against the old one would be meaningless
+    m_mDamageHistory.erase(pMonitor);
+    m_mCaptureStats.erase(pMonitor);
+
+    for (auto& c : m_lClients) {
+        std::erase_if(c.bufferAges, [&](const auto& other) { return other.pMonitor == pMonitor; });
+    }
+}
+
+void CScreencopyProtocolManager::forgetBufferAge(SScreencopyFrame* frame) {
+    // a copy that didn't make it leaves the buffer with unknown contents
+    std::erase_if(frame->client->bufferAges, [&](const auto& other) { return other.buffer == frame->buffer; });
+}
+
+// same output, region and format, one copy can serve all of them
+static bool sameCapture(SScreencopyFrame* a, SScreencopyFrame* b) {
+    if (a->bufferCap != b->bufferCap || !wlr_box_equal(&a->box, &b->box))
+        return false;
+
+    return a->bufferCap == WLR_BUFFER_CAP_DMABUF ? a->dmabufFormat == b->dmabufFormat : a->shmFormat == b->shmFormat;
+}
+
 void CScreencopyProtocolManager::shareAllFrames(CMonitor* pMonitor) {
     if (m_vFramesAwaitingWrite.empty())
         return; // nothing to share
 
-    std::vector<SScreencopyFrame*> framesToRemove;
+    std::vector<SScreencopyFrame*>              framesToRemove;
+    std::vector<SScreencopyFrame*>              framesInFlight;
+    std::vector<std::vector<SScreencopyFrame*>> captures;
 
     // share frame if correct output
     for (auto& f : m_vFramesAwaitingWrite) {
@@ -346,18 +451,43 @@ void CScreencopyProtocolManager::shareAllFrames(CMonitor* pMonitor) {
         if (f->pMonitor != pMonitor)
             continue;
 
-        shareFrame(f);
+        const auto CAPTURE = std::find_if(captures.begin(), captures.end(), [&](const auto& other) { return sameCapture(other.front(), f); });
+        if (CAPTURE != captures.end())
+            CAPTURE->push_back(f);
+        else
+            captures.push_back({f});
+    }
+
+    auto& stats = m_mCaptureStats[pMonitor];
+
+    for (auto& c : captures) {
+        shareFrames(c);
 
-        f->client->lastFrame.reset();
-        ++f->client->frameCounter;
+        if (c.size() > 1)
+            stats.sharedCaptures += c.size();
+        else
+            stats.uniqueCaptures++;
 
-        framesToRemove.push_back(f);
+        for (auto& f : c) {
+            f->client->lastFrame.reset();
+            ++f->client->frameCounter;
+
+            if (f->awaitingReadback)
+                framesInFlight.push_back(f);
+            else
+                framesToRemove.push_back(f);
+        }
     }
 
     for (auto& f : framesToRemove) {
         removeFrame(f);
     }
 
+    // written, but alive until their readback finishes
+    for (auto& f : framesInFlight) {
+        std::erase(m_vFramesAwaitingWrite, f);
+    }
+
     g_pHyprRenderer->m_bSoftwareCursorsLocked = false;
 
     if (m_vFramesAwaitingWrite.empty()) {
@@ -372,93 +502,162 @@ void CScreencopyProtocolManager::shareAllFrames(CMonitor* pMonitor) {
     }
 }
 
-void CScreencopyProtocolManager::shareFrame(SScreencopyFrame* frame) {
-    if (!frame->buffer)
-        return;
-
+void CScreencopyProtocolManager::shareFrames(const std::vector<SScreencopyFrame*>& frames) {
     timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
-    uint32_t flags = 0;
-    if (frame->bufferCap == WLR_BUFFER_CAP_DMABUF) {
-        if (!copyFrameDmabuf(frame)) {
-            zwlr_screencopy_frame_v1_send_failed(frame->resource);
-            return;
+    // one copy has to bring every buffer up to date. Whatever it covers beyond a buffer's own damage is unchanged there anyway.
+    CRegion damage;
+    for (auto& f : frames) {
+        f->damage = getFrameDamage(f);
+        damage.add(f->damage);
+    }
+
+    if (damage.getRects().size() > MAXDAMAGERECTS)
+        damage = CRegion{pixman_region32_extents(damage.pixman())};
+
+    // one client's bad buffer only fails that client's frame
+    const auto FAILED = frames.front()->bufferCap == WLR_BUFFER_CAP_DMABUF ? copyFramesDmabuf(frames, damage) : copyFramesShm(frames, damage, &now);
+
+    for (auto& f : frames) {
+        if (std::ranges::find(FAILED, f) != FAILED.end()) {
+            forgetBufferAge(f);
+            zwlr_screencopy_frame_v1_send_failed(f->resource);
+            continue;
         }
+
+        uint32_t flags = 0;
+        zwlr_screencopy_frame_v1_send_flags(f->resource, flags);
+        sendFrameDamage(f);
+
+        // ready is sent by onReadbackDone
+        if (f->awaitingReadback)
+            continue;
+
+        uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
+        uint32_t tvSecLo = now.tv_sec & 0xFFFFFFFF;
+        zwlr_screencopy_frame_v1_send_ready(f->resource, tvSecHi, tvSecLo, now.tv_nsec);
+    }
+}
+
+void CScreencopyProtocolManager::onReadbackDone(SScreencopyFrame* frame, bool success, timespec now) {
+    if (success) {
+        uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
+        uint32_t tvSecLo = now.tv_sec & 0xFFFFFFFF;
+        zwlr_screencopy_frame_v1_send_ready(frame->resource, tvSecHi, tvSecLo, now.tv_nsec);
     } else {
-        if (!copyFrameShm(frame, &now)) {
-            zwlr_screencopy_frame_v1_send_failed(frame->resource);
-            return;
-        }
+        forgetBufferAge(frame);
+        zwlr_screencopy_frame_v1_send_failed(frame->resource);
     }
 
-    zwlr_screencopy_frame_v1_send_flags(frame->resource, flags);
-    sendFrameDamage(frame);
-    uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
-    uint32_t tvSecLo = now.tv_sec & 0xFFFFFFFF;
-    zwlr_screencopy_frame_v1_send_ready(frame->resource, tvSecHi, tvSecLo, now.tv_nsec);
+    removeFrame(frame);
 }
 
 void CScreencopyProtocolManager::sendFrameDamage(SScreencopyFrame* frame) {
     if (!frame->withDamage)
         return;
 
-    for (auto& RECT : frame->pMonitor->lastFrameDamage.getRects()) {
-
-        if (frame->buffer->width < 1 || frame->buffer->height < 1 || frame->buffer->width - RECT.x1 < 1 || frame->buffer->height - RECT.y1 < 1) {
-            Debug::log(ERR, "[sc] Failed to send damage");
-            break;
-        }
-
-        zwlr_screencopy_frame_v1_send_damage(frame->resource, std::clamp(RECT.x1, 0, frame->buffer->width), std::clamp(RECT.y1, 0, frame->buffer->height),
-                                             std::clamp(RECT.x2 - RECT.x1, 0, frame->buffer->width - RECT.x1), std::clamp(RECT.y2 - RECT.y1, 0, frame->buffer->height - RECT.y1));
+    // what got copied is everything that changed since this buffer was last filled, which covers the client's previous copy as well
+    for (auto& RECT : frame->damage.getRects()) {
+        zwlr_screencopy_frame_v1_send_damage(frame->resource, RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1);
     }
 }
 
-bool CScreencopyProtocolManager::copyFrameShm(SScreencopyFrame* frame, timespec* now) {
-    void*    data;
-    uint32_t format;
-    size_t   stride;
-    if (!wlr_buffer_begin_data_ptr_access(frame->buffer, WLR_BUFFER_DATA_PTR_ACCESS_WRITE, &data, &format, &stride))
-        return false;
+std::vector<SScreencopyFrame*> CScreencopyProtocolManager::copyFramesShm(const std::vector<SScreencopyFrame*>& frames, const CRegion& damage, timespec* now) {
+    const auto FIRST = frames.front();
 
     if (!wlr_renderer_begin_with_buffer(g_pCompositor->m_sWLRRenderer, m_pLastMonitorBackBuffer)) {
         Debug::log(ERR, "[sc] shm: Client requested a copy to a buffer that failed to pass wlr_renderer_begin_with_buffer");
-        wlr_buffer_end_data_ptr_access(frame->buffer);
-        return false;
+        return frames;
+    }
+
+    // wl_shm buffers get their pixels through a pack buffer a frame later instead of stalling the pipeline here,
+    // and every frame of the capture is fed from that one read
+    const auto PFORMAT  = gles2FromDRM(FIRST->shmFormat);
+    const auto PSHMINFO = drm_get_pixel_format_info(FIRST->shmFormat);
+    bool       async    = false;
+    if (PFORMAT && PSHMINFO) {
+        std::vector<SReadbackDestination> destinations;
+        for (auto& f : frames) {
+            destinations.push_back({f, f->bufferResource, [this, f, NOW = *now](bool success) { onReadbackDone(f, success, NOW); }});
+        }
+
+        async = g_pHyprOpenGL->m_sPixelReadback.readPixels(destinations, FIRST->box, damage, PFORMAT->gl_format, PFORMAT->gl_type, PSHMINFO->bpp / 8);
+    }
+
+    std::vector<SScreencopyFrame*> failed;
+    for (auto& f : frames) {
+        f->awaitingReadback = async;
+
+        if (async)
+            continue;
+
+        void*    data;
+        uint32_t format;
+        size_t   stride;
+        if (!wlr_buffer_begin_data_ptr_access(f->buffer, WLR_BUFFER_DATA_PTR_ACCESS_WRITE, &data, &format, &stride)) {
+            failed.push_back(f);
+            continue;
+        }
+
+        bool success = true;
+        for (auto& RECT : damage.getRects()) {
+            success = success &&
+                wlr_renderer_read_pixels(g_pCompositor->m_sWLRRenderer, format, stride, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1, f->box.x + RECT.x1, f->box.y + RECT.y1, RECT.x1,
+                                         RECT.y1, data);
+        }
+
+        wlr_buffer_end_data_ptr_access(f->buffer);
+
+        if (!success)
+            failed.push_back(f);
     }
 
-    bool success = wlr_renderer_read_pixels(g_pCompositor->m_sWLRRenderer, format, stride, frame->box.width, frame->box.height, frame->box.x, frame->box.y, 0, 0, data);
     wlr_renderer_end(g_pCompositor->m_sWLRRenderer);
-    wlr_buffer_end_data_ptr_access(frame->buffer);
 
-    return success;
+    return failed;
 }
 
-bool CScreencopyProtocolManager::copyFrameDmabuf(SScreencopyFrame* frame) {
+std::vector<SScreencopyFrame*> CScreencopyProtocolManager::copyFramesDmabuf(const std::vector<SScreencopyFrame*>& frames, const CRegion& damage) {
+    // imported once, then drawn into every client's buffer
     wlr_texture* sourceTex = wlr_texture_from_buffer(g_pCompositor->m_sWLRRenderer, m_pLastMonitorBackBuffer);
     if (!sourceTex)
-        return false;
+        return frames;
 
-    float glMatrix[9];
+    const auto FIRST = frames.front();
+
+    float      glMatrix[9];
     wlr_matrix_identity(glMatrix);
-    wlr_matrix_translate(glMatrix, -frame->box.x, -frame->box.y);
-    wlr_matrix_scale(glMatrix, frame->pMonitor->vecPixelSize.x, frame->pMonitor->vecPixelSize.y);
+    wlr_matrix_translate(glMatrix, -FIRST->box.x, -FIRST->box.y);
+    wlr_matrix_scale(glMatrix, FIRST->pMonitor->vecPixelSize.x, FIRST->pMonitor->vecPixelSize.y);
+
+    std::vector<SScreencopyFrame*> failed;
+    for (auto& f : frames) {
+        if (!wlr_renderer_begin_with_buffer(g_pCompositor->m_sWLRRenderer, f->buffer)) {
+            Debug::log(ERR, "[sc] dmabuf: Client requested a copy to a buffer that failed to pass wlr_renderer_begin_with_buffer");
+            failed.push_back(f);
+            continue;
+        }
 
-    if (!wlr_renderer_begin_with_buffer(g_pCompositor->m_sWLRRenderer, frame->buffer)) {
-        Debug::log(ERR, "[sc] dmabuf: Client requested a copy to a buffer that failed to pass wlr_renderer_begin_with_buffer");
-        wlr_texture_destroy(sourceTex);
-        return false;
-    }
+        float color[] = {0, 0, 0, 0};
+        for (auto& RECT : damage.getRects()) {
+            wlr_box scissor = {RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1};
+            wlr_renderer_scissor(g_pCompositor->m_sWLRRenderer, &scissor);
 
-    float color[] = {0, 0, 0, 0};
-    wlr_renderer_clear(g_pCompositor->m_sWLRRenderer, color);
-    // TODO: use hl render methods to use damage
-    wlr_render_texture_with_matrix(g_pCompositor->m_sWLRRenderer, sourceTex, glMatrix, 1.0f);
+            wlr_renderer_clear(g_pCompositor->m_sWLRRenderer, color);
+            wlr_render_texture_with_matrix(g_pCompositor->m_sWLRRenderer, sourceTex, glMatrix, 1.0f);
+        }
+        wlr_renderer_scissor(g_pCompositor->m_sWLRRenderer, nullptr);
+
+        wlr_renderer_end(g_pCompositor->m_sWLRRenderer);
+    }
 
     wlr_texture_destroy(sourceTex);
 
-    wlr_renderer_end(g_pCompositor->m_sWLRRenderer);
+    return failed;
+}
 
-    return true;
+SScreencopyCaptureStats CScreencopyProtocolManager::getCaptureStats(CMonitor* pMonitor) {
+    const auto IT = m_mCaptureStats.find(pMonitor);
+    return IT == m_mCaptureStats.end() ? SScreencopyCaptureStats{} : IT->second;
 }
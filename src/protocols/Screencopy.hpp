@@ -3,12 +3,16 @@
 #include "../defines.hpp"
 #include "wlr-screencopy-unstable-v1-protocol.h"
 
+#include <deque>
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include "../managers/HookSystemManager.hpp"
 #include "../helpers/Timer.hpp"
+#include "../helpers/Region.hpp"
 
 class CMonitor;
+class CWindow;
 
 enum eClientOwners
 {
@@ -16,30 +20,62 @@ enum eClientOwners
     CLIENT_TOPLEVEL_EXPORT
 };
 
+// what a client's buffer last got filled with, so a copy_with_damage into it only has to cover what changed since
+struct SScreencopyBufferAge {
+    wlr_buffer*     buffer   = nullptr; // nulled when destroyed
+    CMonitor*       pMonitor = nullptr;
+    wlr_box         box      = {0};
+    uint64_t        seq      = 0; // the output commit its contents are from
+
+    CHyprWLListener hyprListener_destroy;
+};
+
+// when a toplevel export client last got a window, and which version of it
+struct SToplevelExportDelivery {
+    uint64_t version = 0;
+    CTimer   timer;
+};
+
 class CScreencopyClient {
   public:
     CScreencopyClient();
     ~CScreencopyClient();
 
-    int               ref      = 0;
-    wl_resource*      resource = nullptr;
+    int                                                   ref      = 0;
+    wl_resource*                                          resource = nullptr;
+
+    eClientOwners                                         clientOwner = CLIENT_SCREENCOPY;
 
-    eClientOwners     clientOwner = CLIENT_SCREENCOPY;
+    int                                                   frameCounter           = 0;
+    int                                                   framesInLastHalfSecond = 0;
+    CTimer                                                lastMeasure;
+    CTimer                                                lastFrame;
+    bool                                                  sentScreencast = false;
 
-    int               frameCounter           = 0;
-    int               framesInLastHalfSecond = 0;
-    CTimer            lastMeasure;
-    CTimer            lastFrame;
-    bool              sentScreencast = false;
+    std::list<SScreencopyBufferAge>                       bufferAges;
+    std::unordered_map<CWindow*, SToplevelExportDelivery> exportDeliveries; // toplevel export only
 
-    void              onTick();
-    HOOK_CALLBACK_FN* tickCallback = nullptr;
+    void                                                  onTick();
+    HOOK_CALLBACK_FN*                                     tickCallback = nullptr;
 
-    bool              operator==(const CScreencopyClient& other) const {
+    bool                                                  operator==(const CScreencopyClient& other) const {
         return resource == other.resource;
     }
 };
 
+// damage of an output's last few commits in buffer coordinates, newest last
+struct SScreencopyDamageHistory {
+    uint64_t            seq = 0; // bumped on every commit
+    Vector2D            size;
+    std::deque<CRegion> damage;
+};
+
+// frames served by a copy shared with other clients capturing the same thing, and ones that needed their own
+struct SScreencopyCaptureStats {
+    uint64_t sharedCaptures = 0;
+    uint64_t uniqueCaptures = 0;
+};
+
 struct SScreencopyFrame {
     wl_resource*       resource = nullptr;
     CScreencopyClient* client   = nullptr;
@@ -51,10 +87,14 @@ struct SScreencopyFrame {
 
     bool               overlayCursor = false;
     bool               withDamage    = false;
+    CRegion            damage; // box-local, what this copy has to cover
 
     wlr_buffer_cap     bufferCap = WLR_BUFFER_CAP_SHM;
 
-    wlr_buffer*        buffer = nullptr;
+    wlr_buffer*        buffer         = nullptr;
+    wl_resource*       bufferResource = nullptr;
+
+    bool               awaitingReadback = false; // shm pixels are still on their way, ready is sent once they land
 
     CMonitor*          pMonitor = nullptr;
     CWindow*           pWindow  = nullptr;
@@ -68,33 +108,44 @@ class CScreencopyProtocolManager {
   public:
     CScreencopyProtocolManager();
 
-    void bindManager(wl_client* client, void* data, uint32_t version, uint32_t id);
-    void removeClient(CScreencopyClient* client, bool force = false);
-    void removeFrame(SScreencopyFrame* frame, bool force = false);
-    void displayDestroy();
+    void                    bindManager(wl_client* client, void* data, uint32_t version, uint32_t id);
+    void                    removeClient(CScreencopyClient* client, bool force = false);
+    void                    removeFrame(SScreencopyFrame* frame, bool force = false);
+    void                    displayDestroy();
+
+    void                    captureOutput(wl_client* client, wl_resource* resource, uint32_t frame, int32_t overlay_cursor, wl_resource* output, wlr_box box = {0, 0, 0, 0});
 
-    void captureOutput(wl_client* client, wl_resource* resource, uint32_t frame, int32_t overlay_cursor, wl_resource* output, wlr_box box = {0, 0, 0, 0});
+    void                    copyFrame(wl_client* client, wl_resource* resource, wl_resource* buffer);
 
-    void copyFrame(wl_client* client, wl_resource* resource, wl_resource* buffer);
+    void                    onOutputCommit(CMonitor* pMonitor, wlr_output_event_commit* e);
+    void                    onMonitorRemoved(CMonitor* pMonitor);
 
-    void onOutputCommit(CMonitor* pMonitor, wlr_output_event_commit* e);
+    SScreencopyCaptureStats getCaptureStats(CMonitor* pMonitor);
 
   private:
-    wl_global*                     m_pGlobal = nullptr;
-    std::list<SScreencopyFrame>    m_lFrames;
-    std::list<CScreencopyClient>   m_lClients;
+    wl_global*                                              m_pGlobal = nullptr;
+    std::list<SScreencopyFrame>                             m_lFrames;
+    std::list<CScreencopyClient>                            m_lClients;
+
+    wl_listener                                             m_liDisplayDestroy;
 
-    wl_listener                    m_liDisplayDestroy;
+    std::vector<SScreencopyFrame*>                          m_vFramesAwaitingWrite;
 
-    std::vector<SScreencopyFrame*> m_vFramesAwaitingWrite;
+    wlr_buffer*                                             m_pLastMonitorBackBuffer = nullptr;
 
-    wlr_buffer*                    m_pLastMonitorBackBuffer = nullptr;
+    std::unordered_map<CMonitor*, SScreencopyDamageHistory> m_mDamageHistory;
+    std::unordered_map<CMonitor*, SScreencopyCaptureStats>  m_mCaptureStats;
 
-    void                           shareAllFrames(CMonitor* pMonitor);
-    void                           shareFrame(SScreencopyFrame* frame);
-    void                           sendFrameDamage(SScreencopyFrame* frame);
-    bool                           copyFrameDmabuf(SScreencopyFrame* frame);
-    bool                           copyFrameShm(SScreencopyFrame* frame, timespec* now);
+    void                                                    recordCommitDamage(CMonitor* pMonitor, wlr_output_event_commit* e);
+    CRegion                                                 getFrameDamage(SScreencopyFrame* frame);
+    void                                                    forgetBufferAge(SScreencopyFrame* frame);
+    void                                                    shareAllFrames(CMonitor* pMonitor);
+    void                                                    shareFrames(const std::vector<SScreencopyFrame*>& frames);
+    void                                                    sendFrameDamage(SScreencopyFrame* frame);
+    // both return the frames that couldn't be copied
+    std::vector<SScreencopyFrame*>                          copyFramesDmabuf(const std::vector<SScreencopyFrame*>& frames, const CRegion& damage);
+    std::vector<SScreencopyFrame*>                          copyFramesShm(const std::vector<SScreencopyFrame*>& frames, const CRegion& damage, timespec* now);
+    void                                                    onReadbackDone(SScreencopyFrame* frame, bool success, timespec now);
 
     friend class CScreencopyClient;
 };
\ No newline at end of file
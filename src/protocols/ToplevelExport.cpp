@@ -11,6 +11,12 @@ static void bindManagerInt(wl_client* client, void* data, uint32_t version, uint
     g_pProtocolManager->m_pToplevelExportProtocolManager->bindManager(client, data, version, id);
 }
 
+static int handleThrottleTimer(void* data) {
+    ((CToplevelExportProtocolManager*)data)->onThrottleTimer();
+
+    return 0;
+}
+
 static void handleDisplayDestroy(struct wl_listener* listener, void* data) {
     g_pProtocolManager->m_pToplevelExportProtocolManager->displayDestroy();
 }
@@ -36,9 +42,21 @@ CToplevelExportProtocolManager::CToplevelExportProtocolManager() {
     m_liDisplayDestroy.notify = handleDisplayDestroy;
     wl_display_add_destroy_listener(g_pCompositor->m_sWLDisplay, &m_liDisplayDestroy);
 
+    m_pThrottleTimer = wl_event_loop_add_timer(g_pCompositor->m_sWLEventLoop, handleThrottleTimer, this);
+
     Debug::log(LOG, "ToplevelExportManager started successfully!");
 }
 
+// the window in output buffer pixels, before any thumbnail downscale
+static wlr_box windowBufferBox(CWindow* pWindow, CMonitor* pMonitor) {
+    wlr_box box = {0, 0, (int)(pWindow->m_vRealSize.vec().x * pMonitor->scale), (int)(pWindow->m_vRealSize.vec().y * pMonitor->scale)};
+    int     ow, oh;
+    wlr_output_effective_resolution(pMonitor->output, &ow, &oh);
+    wlr_box_transform(&box, &box, pMonitor->transform, ow, oh);
+
+    return box;
+}
+
 wlr_foreign_toplevel_handle_v1* zwlrHandleFromResource(wl_resource* resource) {
     // we can't assert here, but it doesnt matter.
     return (wlr_foreign_toplevel_handle_v1*)wl_resource_get_user_data(resource);
@@ -93,6 +111,12 @@ void CToplevelExportProtocolManager::removeClient(CScreencopyClient* client, boo
     }
 
     m_lClients.remove(*client); // TODO: this doesn't get cleaned up after sharing app exits???
+
+    // nobody left to export to
+    if (m_lClients.empty()) {
+        m_mWindowCaches.clear();
+        m_sOverlayFB.release();
+    }
 }
 
 static void handleManagerResourceDestroy(wl_resource* resource) {
@@ -132,6 +156,7 @@ void CToplevelExportProtocolManager::removeFrame(SScreencopyFrame* frame, bool f
         return;
 
     std::erase_if(m_vFramesAwaitingWrite, [&](const auto& other) { return other == frame; });
+    g_pHyprOpenGL->m_sPixelReadback.cancel(frame);
 
     wl_resource_set_user_data(frame->resource, nullptr);
     wlr_buffer_unlock(frame->buffer);
@@ -140,7 +165,9 @@ void CToplevelExportProtocolManager::removeFrame(SScreencopyFrame* frame, bool f
 }
 
 void CToplevelExportProtocolManager::captureToplevel(wl_client* client, wl_resource* resource, uint32_t frame, int32_t overlay_cursor, CWindow* pWindow) {
-    const auto PCLIENT = clientFromResource(resource);
+    static auto* const PMAXSIZE = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_size")->intValue;
+
+    const auto         PCLIENT = clientFromResource(resource);
 
     // create a frame
     const auto PFRAME     = &m_lFrames.emplace_back();
@@ -198,10 +225,14 @@ void CToplevelExportProtocolManager::captureToplevel(wl_client* client, wl_resou
         PFRAME->dmabufFormat = DRM_FORMAT_INVALID;
     }
 
-    PFRAME->box = {0, 0, (int)(PFRAME->pWindow->m_vRealSize.vec().x * PMONITOR->scale), (int)(PFRAME->pWindow->m_vRealSize.vec().y * PMONITOR->scale)};
-    int ow, oh;
-    wlr_output_effective_resolution(PMONITOR->output, &ow, &oh);
-    wlr_box_transform(&PFRAME->box, &PFRAME->box, PMONITOR->transform, ow, oh);
+    PFRAME->box = windowBufferBox(PFRAME->pWindow, PMONITOR);
+
+    // capped for every export, not just thumbnails (see misc:toplevel_export_max_size), the window gets scaled down into it on the gpu
+    if (*PMAXSIZE > 0 && (PFRAME->box.width > *PMAXSIZE || PFRAME->box.height > *PMAXSIZE)) {
+        const double SCALE = std::min((double)*PMAXSIZE / PFRAME->box.width, (double)*PMAXSIZE / PFRAME->box.height);
+        PFRAME->box.width  = std::max((int)(PFRAME->box.width * SCALE), 2);
+        PFRAME->box.height = std::max((int)(PFRAME->box.height * SCALE), 2);
+    }
 
     PFRAME->shmStride = (PSHMINFO->bpp / 8) * PFRAME->box.width;
 
@@ -215,7 +246,9 @@ void CToplevelExportProtocolManager::captureToplevel(wl_client* client, wl_resou
 }
 
 void CToplevelExportProtocolManager::copyFrame(wl_client* client, wl_resource* resource, wl_resource* buffer, int32_t ignore_damage) {
-    const auto PFRAME = frameFromResource(resource);
+    static auto* const PMAXFPS = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_fps")->intValue;
+
+    const auto         PFRAME = frameFromResource(resource);
 
     if (!PFRAME) {
         Debug::log(ERR, "No frame in copyFrame??");
@@ -278,23 +311,34 @@ void CToplevelExportProtocolManager::copyFrame(wl_client* client, wl_resource* r
         return;
     }
 
-    PFRAME->buffer = PBUFFER;
+    PFRAME->buffer         = PBUFFER;
+    PFRAME->bufferResource = buffer;
+    PFRAME->withDamage     = !ignore_damage;
 
     m_vFramesAwaitingWrite.emplace_back(PFRAME);
+
+    if (*PMAXFPS > 0)
+        wl_event_source_timer_update(m_pThrottleTimer, 1);
 }
 
 void CToplevelExportProtocolManager::onOutputCommit(CMonitor* pMonitor, wlr_output_event_commit* e) {
+    static auto* const PMAXFPS = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_fps")->intValue;
+
     if (m_vFramesAwaitingWrite.empty())
         return; // nothing to share
 
+    // rate limited, onThrottleTimer serves them
+    if (*PMAXFPS > 0)
+        return;
+
     const auto                     PMONITOR = g_pCompositor->getMonitorFromOutput(e->output);
 
-    std::vector<SScreencopyFrame*> framesToRemove;
+    std::vector<SScreencopyFrame*> frames;
 
     // share frame if correct output
     for (auto& f : m_vFramesAwaitingWrite) {
         if (!f->pWindow) {
-            framesToRemove.push_back(f);
+            frames.push_back(f);
             continue;
         }
 
@@ -306,17 +350,88 @@ void CToplevelExportProtocolManager::onOutputCommit(CMonitor* pMonitor, wlr_outp
         if (!wlr_output_layout_intersects(g_pCompositor->m_sWLROutputLayout, pMonitor->output, &geometry))
             continue;
 
+        frames.push_back(f);
+    }
+
+    shareFrames(frames);
+}
+
+void CToplevelExportProtocolManager::onThrottleTimer() {
+    static auto* const PMAXFPS = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_fps")->intValue;
+
+    if (*PMAXFPS <= 0)
+        return;
+
+    std::vector<SScreencopyFrame*> frames;
+    int                            nextMs = -1;
+
+    for (auto& f : m_vFramesAwaitingWrite) {
+        // the cache doesn't need the output, so these don't wait for one to commit
+        const auto DELAY = f->pWindow ? getThrottleDelay(f) : 0;
+
+        if (DELAY == 0)
+            frames.push_back(f);
+        else if (DELAY > 0)
+            nextMs = nextMs < 0 ? DELAY : std::min(nextMs, DELAY);
+    }
+
+    shareFrames(frames);
+
+    // frames waiting for the window to change are woken by invalidateWindow
+    if (nextMs > 0)
+        wl_event_source_timer_update(m_pThrottleTimer, nextMs);
+}
+
+int CToplevelExportProtocolManager::getThrottleDelay(SScreencopyFrame* frame) {
+    static auto* const PMAXFPS = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_fps")->intValue;
+
+    const auto         DELIVERY = frame->client->exportDeliveries.find(frame->pWindow);
+    if (DELIVERY == frame->client->exportDeliveries.end())
+        return 0; // never got this window
+
+    // nothing new since the last one, unless the client asked for a copy regardless
+    const auto CACHE = m_mWindowCaches.find(frame->pWindow);
+    if (frame->withDamage && CACHE != m_mWindowCaches.end() && CACHE->second.version == DELIVERY->second.version)
+        return -1;
+
+    return std::max(1000 / *PMAXFPS - DELIVERY->second.timer.getMillis(), 0);
+}
+
+void CToplevelExportProtocolManager::shareFrames(const std::vector<SScreencopyFrame*>& frames) {
+    std::vector<SScreencopyFrame*> framesToRemove;
+    std::vector<SScreencopyFrame*> framesInFlight;
+
+    for (auto& f : frames) {
+        if (!f->pWindow) {
+            framesToRemove.push_back(f);
+            continue;
+        }
+
         shareFrame(f);
 
+        auto& delivery = f->client->exportDeliveries[f->pWindow];
+        delivery.timer.reset();
+
+        if (const auto CACHE = m_mWindowCaches.find(f->pWindow); CACHE != m_mWindowCaches.end())
+            delivery.version = CACHE->second.version;
+
         f->client->lastFrame.reset();
         ++f->client->frameCounter;
 
-        framesToRemove.push_back(f);
+        if (f->awaitingReadback)
+            framesInFlight.push_back(f);
+        else
+            framesToRemove.push_back(f);
     }
 
     for (auto& f : framesToRemove) {
         removeFrame(f);
     }
+
+    // written, but alive until their readback finishes
+    for (auto& f : framesInFlight) {
+        std::erase(m_vFramesAwaitingWrite, f);
+    }
 }
 
 void CToplevelExportProtocolManager::shareFrame(SScreencopyFrame* frame) {
@@ -341,96 +456,183 @@ void CToplevelExportProtocolManager::shareFrame(SScreencopyFrame* frame) {
 
     hyprland_toplevel_export_frame_v1_send_flags(frame->resource, flags);
     sendDamage(frame);
+
+    // ready is sent by onReadbackDone
+    if (frame->awaitingReadback)
+        return;
+
     uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
     uint32_t tvSecLo = now.tv_sec & 0xFFFFFFFF;
     hyprland_toplevel_export_frame_v1_send_ready(frame->resource, tvSecHi, tvSecLo, now.tv_nsec);
 }
 
+void CToplevelExportProtocolManager::onReadbackDone(SScreencopyFrame* frame, bool success, timespec now) {
+    if (success) {
+        uint32_t tvSecHi = (sizeof(now.tv_sec) > 4) ? now.tv_sec >> 32 : 0;
+        uint32_t tvSecLo = now.tv_sec & 0xFFFFFFFF;
+        hyprland_toplevel_export_frame_v1_send_ready(frame->resource, tvSecHi, tvSecLo, now.tv_nsec);
+    } else
+        hyprland_toplevel_export_frame_v1_send_failed(frame->resource);
+
+    removeFrame(frame);
+}
+
+double CToplevelExportProtocolManager::getFrameScale(SScreencopyFrame* frame) {
+    static auto* const PMAXSIZE = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_size")->intValue;
+
+    const auto         PMONITOR = g_pCompositor->getMonitorFromID(frame->pWindow->m_iMonitorID);
+    if (*PMAXSIZE <= 0 || !PMONITOR)
+        return 1.0;
+
+    const auto FULLBOX = windowBufferBox(frame->pWindow, PMONITOR);
+    if (FULLBOX.width <= 0 || FULLBOX.height <= 0)
+        return 1.0;
+
+    return std::min({1.0, (double)frame->box.width / FULLBOX.width, (double)frame->box.height / FULLBOX.height});
+}
+
 void CToplevelExportProtocolManager::sendDamage(SScreencopyFrame* frame) {
     // TODO: send proper dmg
     hyprland_toplevel_export_frame_v1_send_damage(frame->resource, 0, 0, frame->box.width, frame->box.height);
 }
 
-bool CToplevelExportProtocolManager::copyFrameShm(SScreencopyFrame* frame, timespec* now) {
-    void*    data;
-    uint32_t format;
-    size_t   stride;
-    if (!wlr_buffer_begin_data_ptr_access(frame->buffer, WLR_BUFFER_DATA_PTR_ACCESS_WRITE, &data, &format, &stride))
-        return false;
+CFramebuffer* CToplevelExportProtocolManager::getWindowCache(SScreencopyFrame* frame, timespec* now) {
+    const auto     PMONITOR = g_pCompositor->getMonitorFromID(frame->pWindow->m_iMonitorID);
+    const Vector2D SIZE     = {frame->box.width, frame->box.height};
 
-    // render the client
-    const auto PMONITOR = g_pCompositor->getMonitorFromID(frame->pWindow->m_iMonitorID);
-    CRegion    fakeDamage{0, 0, PMONITOR->vecPixelSize.x * 10, PMONITOR->vecPixelSize.y * 10};
+    if (!PMONITOR || SIZE.x <= 1 || SIZE.y <= 1)
+        return nullptr;
 
-    if (frame->overlayCursor)
-        wlr_output_lock_software_cursors(PMONITOR->output, true);
+    if (eglGetCurrentContext() != wlr_egl_get_context(g_pCompositor->m_sWLREGL))
+        eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, wlr_egl_get_context(g_pCompositor->m_sWLREGL));
 
-    if (!wlr_output_attach_render(PMONITOR->output, nullptr)) {
-        Debug::log(ERR, "[toplevel_export] Couldn't attach render");
-        wlr_buffer_end_data_ptr_access(frame->buffer);
-        if (frame->overlayCursor)
-            wlr_output_lock_software_cursors(PMONITOR->output, false);
-        return false;
-    }
+    const auto PCACHE = &m_mWindowCaches[frame->pWindow];
+
+    if (!PCACHE->dirty && PCACHE->fb.m_vSize == SIZE)
+        return &PCACHE->fb;
 
+    // drawn straight into the cache, the output and the monitor's framebuffers are left alone
+    CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
     g_pHyprOpenGL->begin(PMONITOR, &fakeDamage, true);
+
+    // blur would sample the monitor's framebuffers, see makeWindowSnapshot
+    const auto BLURVAL = g_pConfigManager->getInt("decoration:blur:enabled");
+    g_pConfigManager->setInt("decoration:blur:enabled", 0);
+
+    PCACHE->fb.alloc(SIZE.x, SIZE.y);
+    PCACHE->fb.bind();
+
     g_pHyprOpenGL->clear(CColor(0, 0, 0, 1.0));
 
-    // render client at 0,0
+    // render client at 0,0, scaled down to the thumbnail size if there is one
+    g_pHyprOpenGL->m_RenderData.renderModif = {{}, (float)getFrameScale(frame)};
+
     g_pHyprRenderer->m_bBlockSurfaceFeedback = g_pHyprRenderer->shouldRenderWindow(frame->pWindow); // block the feedback to avoid spamming the surface if it's visible
     g_pHyprRenderer->renderWindow(frame->pWindow, PMONITOR, now, false, RENDER_PASS_ALL, true, true);
     g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
 
-    if (frame->overlayCursor && wlr_renderer_begin(g_pCompositor->m_sWLRRenderer, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y)) {
-        // hack le massive
-        wlr_output_cursor* cursor;
-        const auto         OFFSET = frame->pWindow->m_vRealPosition.vec() - PMONITOR->vecPosition;
-        wl_list_for_each(cursor, &PMONITOR->output->cursors, link) {
-            if (!cursor->enabled || !cursor->visible || PMONITOR->output->hardware_cursor == cursor) {
-                continue;
-            }
-            cursor->x -= OFFSET.x;
-            cursor->y -= OFFSET.y;
-        }
-        wlr_output_render_software_cursors(PMONITOR->output, NULL);
-        wl_list_for_each(cursor, &PMONITOR->output->cursors, link) {
-            if (!cursor->enabled || !cursor->visible || PMONITOR->output->hardware_cursor == cursor) {
-                continue;
-            }
-            cursor->x += OFFSET.x;
-            cursor->y += OFFSET.y;
-        }
-        wlr_renderer_end(g_pCompositor->m_sWLRRenderer);
+    g_pHyprOpenGL->m_RenderData.renderModif = {};
+
+    g_pConfigManager->setInt("decoration:blur:enabled", BLURVAL);
+
+    g_pHyprOpenGL->end();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, g_pHyprOpenGL->m_iCurrentOutputFb);
+
+    PCACHE->dirty = false;
+
+    return &PCACHE->fb;
+}
+
+void CToplevelExportProtocolManager::renderFromCache(SScreencopyFrame* frame, CFramebuffer* pCache) {
+    const auto PMONITOR = g_pHyprOpenGL->m_RenderData.pMonitor;
+
+    wlr_box    box = {0, 0, pCache->m_vSize.x, pCache->m_vSize.y};
+    g_pHyprOpenGL->renderTexture(pCache->m_cTex, &box, 1.f);
+
+    if (!frame->overlayCursor)
+        return;
+
+    // the cursors as they are on the output, moved into the window's space. They move without the window committing, so they never go in the cache.
+    const auto         OFFSET   = (frame->pWindow->m_vRealPosition.vec() - PMONITOR->vecPosition) * PMONITOR->scale;
+    const auto         WINDOWPX = frame->pWindow->m_vRealSize.vec() * PMONITOR->scale;
+    const auto         SCALE    = getFrameScale(frame);
+
+    wlr_output_cursor* cursor;
+    wl_list_for_each(cursor, &PMONITOR->output->cursors, link) {
+        if (!cursor->enabled || !cursor->visible || !cursor->texture)
+            continue;
+
+        // cursor coords are output pixels before the transform, the cache is in buffer orientation (see windowBufferBox).
+        // Transformed within the window the same way wlroots places software cursors within the output.
+        wlr_box cursorBox = {cursor->x - cursor->hotspot_x - OFFSET.x, cursor->y - cursor->hotspot_y - OFFSET.y, cursor->width, cursor->height};
+        wlr_box_transform(&cursorBox, &cursorBox, wlr_output_transform_invert(PMONITOR->transform), WINDOWPX.x, WINDOWPX.y);
+        scaleBox(&cursorBox, SCALE);
+
+        g_pHyprOpenGL->renderTexture(cursor->texture, &cursorBox, 1.f);
     }
+}
+
+bool CToplevelExportProtocolManager::copyFrameShm(SScreencopyFrame* frame, timespec* now) {
+    void*    data;
+    uint32_t format;
+    size_t   stride;
+    if (!wlr_buffer_begin_data_ptr_access(frame->buffer, WLR_BUFFER_DATA_PTR_ACCESS_WRITE, &data, &format, &stride))
+        return false;
 
-    // copy pixels
     const auto PFORMAT = gles2FromDRM(format);
     if (!PFORMAT) {
         Debug::log(ERR, "[toplevel_export] Cannot read pixels, unsupported format {:x}", (uintptr_t)PFORMAT);
-        g_pHyprOpenGL->end();
         wlr_buffer_end_data_ptr_access(frame->buffer);
-        if (frame->overlayCursor)
-            wlr_output_lock_software_cursors(PMONITOR->output, false);
         return false;
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, g_pHyprOpenGL->m_RenderData.pCurrentMonData->primaryFB.m_iFb);
+    auto PSOURCE = getWindowCache(frame, now);
+    if (!PSOURCE) {
+        wlr_buffer_end_data_ptr_access(frame->buffer);
+        return false;
+    }
 
-    glReadPixels(0, 0, frame->box.width, frame->box.height, PFORMAT->gl_format, PFORMAT->gl_type, data);
+    // the cursor goes on top of a copy of the cache
+    if (frame->overlayCursor) {
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(frame->pWindow->m_iMonitorID);
+        CRegion    fakeDamage{0, 0, INT16_MAX, INT16_MAX};
 
-    g_pHyprOpenGL->end();
+        g_pHyprOpenGL->begin(PMONITOR, &fakeDamage, true);
 
-    wlr_output_rollback(PMONITOR->output);
+        m_sOverlayFB.alloc(PSOURCE->m_vSize.x, PSOURCE->m_vSize.y);
+        m_sOverlayFB.bind();
 
-    wlr_buffer_end_data_ptr_access(frame->buffer);
+        renderFromCache(frame, PSOURCE);
+
+        g_pHyprOpenGL->end();
 
-    if (frame->overlayCursor)
-        wlr_output_lock_software_cursors(PMONITOR->output, false);
+        PSOURCE = &m_sOverlayFB;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, PSOURCE->m_iFb);
+
+    // wl_shm buffers get their pixels through a pack buffer a frame later instead of stalling the pipeline here
+    const auto PSHMINFO     = drm_get_pixel_format_info(format);
+    frame->awaitingReadback = PSHMINFO &&
+        g_pHyprOpenGL->m_sPixelReadback.readPixels({{frame, frame->bufferResource, [this, frame, NOW = *now](bool success) { onReadbackDone(frame, success, NOW); }}}, frame->box,
+                                                   CRegion{0, 0, frame->box.width, frame->box.height}, PFORMAT->gl_format, PFORMAT->gl_type, PSHMINFO->bpp / 8);
+
+    if (!frame->awaitingReadback)
+        glReadPixels(0, 0, frame->box.width, frame->box.height, PFORMAT->gl_format, PFORMAT->gl_type, data);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, g_pHyprOpenGL->m_iCurrentOutputFb);
+
+    wlr_buffer_end_data_ptr_access(frame->buffer);
 
     return true;
 }
 
 bool CToplevelExportProtocolManager::copyFrameDmabuf(SScreencopyFrame* frame, timespec* now) {
+    const auto PCACHE = getWindowCache(frame, now);
+    if (!PCACHE)
+        return false;
+
     if (!wlr_renderer_begin_with_buffer(g_pCompositor->m_sWLRRenderer, frame->buffer))
         return false;
 
@@ -440,16 +642,9 @@ bool CToplevelExportProtocolManager::copyFrameDmabuf(SScreencopyFrame* frame, ti
 
     g_pHyprOpenGL->begin(PMONITOR, &fakeDamage, true);
 
-    g_pHyprOpenGL->clear(CColor(0, 0, 0, 1.0));
-
-    g_pHyprRenderer->m_bBlockSurfaceFeedback = g_pHyprRenderer->shouldRenderWindow(frame->pWindow); // block the feedback to avoid spamming the surface if it's visible
-    g_pHyprRenderer->renderWindow(frame->pWindow, PMONITOR, now, false, RENDER_PASS_ALL, true, true);
-    g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
-
     g_pHyprOpenGL->bindWlrOutputFb();
 
-    wlr_box monbox = {0, 0, PMONITOR->vecPixelSize.x, PMONITOR->vecPixelSize.y};
-    g_pHyprOpenGL->renderTexture(g_pHyprOpenGL->m_RenderData.pCurrentMonData->primaryFB.m_cTex, &monbox, 1.f);
+    renderFromCache(frame, PCACHE);
 
     g_pHyprOpenGL->end();
 
@@ -457,9 +652,36 @@ bool CToplevelExportProtocolManager::copyFrameDmabuf(SScreencopyFrame* frame, ti
     return true;
 }
 
+void CToplevelExportProtocolManager::invalidateWindow(CWindow* pWindow) {
+    static auto* const PMAXFPS = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_fps")->intValue;
+
+    const auto         IT = m_mWindowCaches.find(pWindow);
+    if (IT == m_mWindowCaches.end())
+        return;
+
+    IT->second.dirty = true;
+    IT->second.version++;
+
+    // frames held back until the window had something new can go now
+    if (*PMAXFPS > 0 && std::ranges::any_of(m_vFramesAwaitingWrite, [&](const auto& other) { return other->pWindow == pWindow; }))
+        wl_event_source_timer_update(m_pThrottleTimer, 1);
+}
+
 void CToplevelExportProtocolManager::onWindowUnmap(CWindow* pWindow) {
+    static auto* const PMAXFPS = &g_pConfigManager->getConfigValuePtr("misc:toplevel_export_max_fps")->intValue;
+
     for (auto& f : m_lFrames) {
         if (f.pWindow == pWindow)
             f.pWindow = nullptr;
     }
+
+    m_mWindowCaches.erase(pWindow);
+
+    for (auto& c : m_lClients) {
+        c.exportDeliveries.erase(pWindow);
+    }
+
+    // the timer is what drops the frames of a window that's gone when they're rate limited
+    if (*PMAXFPS > 0 && !m_vFramesAwaitingWrite.empty())
+        wl_event_source_timer_update(m_pThrottleTimer, 1);
 }
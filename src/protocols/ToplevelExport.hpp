@@ -4,13 +4,22 @@
 #include "wlr-foreign-toplevel-management-unstable-v1-protocol.h"
 #include "hyprland-toplevel-export-v1-protocol.h"
 #include "Screencopy.hpp"
+#include "../render/Framebuffer.hpp"
 
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 class CMonitor;
 class CWindow;
 
+// a window as last rendered, exports are served from it instead of rendering the window for each of them
+struct SToplevelExportCache {
+    CFramebuffer fb;
+    bool         dirty   = true;
+    uint64_t     version = 0; // bumped on every invalidateWindow
+};
+
 class CToplevelExportProtocolManager {
   public:
     CToplevelExportProtocolManager();
@@ -22,21 +31,35 @@ class CToplevelExportProtocolManager {
     void copyFrame(wl_client* client, wl_resource* resource, wl_resource* buffer, int32_t ignore_damage);
     void displayDestroy();
     void onWindowUnmap(CWindow* pWindow);
+    // anything that changes how the window renders: surface commits, but also its animated values (alpha, border, dim, shadow) and decorations
+    void invalidateWindow(CWindow* pWindow);
     void onOutputCommit(CMonitor* pMonitor, wlr_output_event_commit* e);
+    void onThrottleTimer();
 
   private:
-    wl_global*                     m_pGlobal = nullptr;
-    std::list<SScreencopyFrame>    m_lFrames;
-    std::list<CScreencopyClient>   m_lClients;
+    wl_global*                                         m_pGlobal = nullptr;
+    std::list<SScreencopyFrame>                        m_lFrames;
+    std::list<CScreencopyClient>                       m_lClients;
+
+    wl_listener                                        m_liDisplayDestroy;
+
+    std::vector<SScreencopyFrame*>                     m_vFramesAwaitingWrite;
 
-    wl_listener                    m_liDisplayDestroy;
+    wl_event_source*                                   m_pThrottleTimer = nullptr; // serves frames when misc:toplevel_export_max_fps is set
 
-    std::vector<SScreencopyFrame*> m_vFramesAwaitingWrite;
+    std::unordered_map<CWindow*, SToplevelExportCache> m_mWindowCaches;
+    CFramebuffer                                       m_sOverlayFB; // cache + cursor, for frames that want the cursor
 
-    void                           shareFrame(SScreencopyFrame* frame);
-    bool                           copyFrameDmabuf(SScreencopyFrame* frame, timespec* now);
-    bool                           copyFrameShm(SScreencopyFrame* frame, timespec* now);
-    void                           sendDamage(SScreencopyFrame* frame);
+    void                                               shareFrames(const std::vector<SScreencopyFrame*>& frames);
+    void                                               shareFrame(SScreencopyFrame* frame);
+    int                                                getThrottleDelay(SScreencopyFrame* frame);
+    double                                             getFrameScale(SScreencopyFrame* frame);
+    CFramebuffer*                                      getWindowCache(SScreencopyFrame* frame, timespec* now);
+    void                                               renderFromCache(SScreencopyFrame* frame, CFramebuffer* pCache);
+    bool                                               copyFrameDmabuf(SScreencopyFrame* frame, timespec* now);
+    bool                                               copyFrameShm(SScreencopyFrame* frame, timespec* now);
+    void                                               sendDamage(SScreencopyFrame* frame);
+    void                                               onReadbackDone(SScreencopyFrame* frame, bool success, timespec now);
 
     friend class CScreencopyClient;
 };
\ No newline at end of file
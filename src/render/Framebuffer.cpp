@@ -54,6 +54,8 @@ bool CFramebuffer::alloc(int w, int h) {
 }
 
 void CFramebuffer::bind() {
+    g_pHyprOpenGL->flushQuadBatch();
+
 #ifndef GLES2
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iFb);
 #else
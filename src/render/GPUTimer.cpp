@@ -0,0 +1,218 @@
+#include "GPUTimer.hpp"
+#include "../Compositor.hpp"
+
+// not in the GLES3 headers, both come with GL_EXT_disjoint_timer_query
+#ifndef GL_TIME_ELAPSED_EXT
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+// frames still waiting on their results after this many newer ones are dropped instead of waited on
+constexpr size_t GPUTIMERMAXPENDING = 8;
+// frames averaged on outputs without a refresh rate
+constexpr size_t GPUTIMERFALLBACKHISTORY = 60;
+
+void             CGPUTimer::init(const std::string& extensions) {
+#ifndef GLES2
+    m_bSupported = extensions.contains("GL_EXT_disjoint_timer_query");
+#endif
+
+    Debug::log(LOG, "GPU timer queries {}", m_bSupported ? "supported" : "unsupported, GPU timing will be unavailable");
+}
+
+bool CGPUTimer::supported() {
+    return m_bSupported;
+}
+
+bool CGPUTimer::running() {
+    return m_bRunning;
+}
+
+void CGPUTimer::beginFrame(CMonitor* pMonitor) {
+    static auto* const PGPUTIMING    = &g_pConfigManager->getConfigValuePtr("debug:gpu_timing")->intValue;
+    static auto* const PDEBUGOVERLAY = &g_pConfigManager->getConfigValuePtr("debug:overlay")->intValue;
+
+    collect();
+
+    if (!m_bSupported || (!*PGPUTIMING && !*PDEBUGOVERLAY))
+        return;
+
+    m_sCurrentFrame.pMonitor = pMonitor;
+    m_sCurrentFrame.queries.clear();
+    m_eStage   = GPU_STAGE_NONE;
+    m_bRunning = true;
+}
+
+void CGPUTimer::endFrame() {
+    if (!m_bRunning)
+        return;
+
+    stage(GPU_STAGE_NONE);
+    m_bRunning = false;
+
+    if (m_sCurrentFrame.queries.empty())
+        return;
+
+    m_dPendingFrames.emplace_back(std::move(m_sCurrentFrame));
+    m_sCurrentFrame = {};
+
+    while (m_dPendingFrames.size() > GPUTIMERMAXPENDING) {
+        releaseFrame(m_dPendingFrames.front());
+        m_dPendingFrames.pop_front();
+        m_sStats.droppedFrames++;
+    }
+}
+
+eGPUTimerStage CGPUTimer::stage(eGPUTimerStage stage) {
+    const auto PREVSTAGE = m_eStage;
+
+    if (!m_bRunning || stage == m_eStage)
+        return PREVSTAGE;
+
+#ifndef GLES2
+    // time elapsed queries can't nest, so stages are strictly sequential
+    if (m_eStage != GPU_STAGE_NONE)
+        glEndQuery(GL_TIME_ELAPSED_EXT);
+
+    if (stage != GPU_STAGE_NONE) {
+        const auto QUERY = getQuery();
+        glBeginQuery(GL_TIME_ELAPSED_EXT, QUERY);
+        m_sCurrentFrame.queries.push_back({stage, QUERY});
+    }
+#endif
+
+    m_eStage = stage;
+
+    return PREVSTAGE;
+}
+
+void CGPUTimer::collect() {
+#ifndef GLES2
+    if (m_dPendingFrames.empty())
+        return;
+
+    // queries finish in submission order, once a frame's last one is available the whole frame is.
+    size_t ready = 0;
+    for (auto& f : m_dPendingFrames) {
+        GLuint available = 0;
+        glGetQueryObjectuiv(f.queries.back().second, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (!available)
+            break;
+
+        ready++;
+    }
+
+    if (ready == 0)
+        return;
+
+    // a disjoint operation (clock change, power state, ...) leaves the results of everything in flight undefined
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    for (size_t i = 0; i < ready; ++i) {
+        auto& frame = m_dPendingFrames.front();
+
+        if (disjoint) {
+            m_sStats.discardedFrames++;
+        } else {
+            std::array<float, GPU_STAGE_COUNT> times = {};
+
+            for (auto& [stage, query] : frame.queries) {
+                GLuint ns = 0;
+                glGetQueryObjectuiv(query, GL_QUERY_RESULT, &ns);
+                times[stage] += ns / 1000000.f;
+            }
+
+            // about a second of frames. Headless and some virtual outputs report no refresh rate at all.
+            const size_t HISTORY = frame.pMonitor->refreshRate >= 1.f ? (size_t)frame.pMonitor->refreshRate : GPUTIMERFALLBACKHISTORY;
+
+            auto&        monitorTimes = m_mMonitorTimes[frame.pMonitor];
+            monitorTimes.push_back(times);
+
+            while (monitorTimes.size() > HISTORY)
+                monitorTimes.pop_front();
+
+            m_sStats.collectedFrames++;
+        }
+
+        releaseFrame(frame);
+        m_dPendingFrames.pop_front();
+    }
+#endif
+}
+
+GLuint CGPUTimer::getQuery() {
+    GLuint query = 0;
+
+#ifndef GLES2
+    if (!m_vFreeQueries.empty()) {
+        query = m_vFreeQueries.back();
+        m_vFreeQueries.pop_back();
+    } else
+        glGenQueries(1, &query);
+#endif
+
+    return query;
+}
+
+void CGPUTimer::releaseFrame(SQueryFrame& frame) {
+    // a query object may be restarted before its old result was read, the result is simply replaced
+    for (auto& [stage, query] : frame.queries) {
+        m_vFreeQueries.push_back(query);
+    }
+
+    frame.queries.clear();
+}
+
+SGPUFrameTimes CGPUTimer::getFrameTimes(CMonitor* pMonitor) {
+    SGPUFrameTimes result;
+
+    const auto     IT = m_mMonitorTimes.find(pMonitor);
+    if (IT == m_mMonitorTimes.end() || IT->second.empty())
+        return result;
+
+    for (auto& times : IT->second) {
+        float total = 0;
+        for (size_t i = 0; i < GPU_STAGE_COUNT; ++i) {
+            result.stages[i] += times[i];
+            total += times[i];
+        }
+
+        result.total += total;
+        result.max = std::max(result.max, total);
+    }
+
+    result.frames = IT->second.size();
+
+    for (auto& s : result.stages) {
+        s /= result.frames;
+    }
+
+    result.total /= result.frames;
+
+    return result;
+}
+
+SGPUTimerStats CGPUTimer::getStats() {
+    return m_sStats;
+}
+
+void CGPUTimer::destroyMonitor(CMonitor* pMonitor) {
+    if (m_bRunning && m_sCurrentFrame.pMonitor == pMonitor) {
+        stage(GPU_STAGE_NONE);
+        m_bRunning = false;
+        releaseFrame(m_sCurrentFrame);
+    }
+
+    for (auto& f : m_dPendingFrames) {
+        if (f.pMonitor == pMonitor)
+            releaseFrame(f);
+    }
+
+    std::erase_if(m_dPendingFrames, [&](const auto& other) { return other.queries.empty(); });
+
+    m_mMonitorTimes.erase(pMonitor);
+}
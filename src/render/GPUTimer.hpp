@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <array>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+
+class CMonitor;
+
+enum eGPUTimerStage
+{
+    GPU_STAGE_NONE = -1,
+    GPU_STAGE_CLEAR,
+    GPU_STAGE_WINDOWS,
+    GPU_STAGE_BLUR,
+    GPU_STAGE_DECORATIONS,
+    GPU_STAGE_OVERLAYS,
+    GPU_STAGE_CURSOR,
+    GPU_STAGE_PRESENT,
+    GPU_STAGE_COUNT
+};
+
+inline const char* GPUSTAGENAMES[GPU_STAGE_COUNT] = {"clear", "windows", "blur", "decorations", "overlays", "cursor", "present"};
+
+struct SGPUFrameTimes {
+    std::array<float, GPU_STAGE_COUNT> stages = {}; // avg ms per stage
+    float                              total  = 0;  // avg ms per frame
+    float                              max    = 0;  // worst frame, ms
+    size_t                             frames = 0;  // frames the averages are over
+};
+
+struct SGPUTimerStats {
+    uint64_t collectedFrames = 0;
+    uint64_t discardedFrames = 0; // a disjoint event made the results meaningless
+    uint64_t droppedFrames   = 0; // results did not arrive within GPUTIMERMAXPENDING frames
+};
+
+/*  GPU time per render stage from GL_EXT_disjoint_timer_query.
+    Stages are timed back to back with GL_TIME_ELAPSED queries, which are read back a few frames later once available,
+    so nothing ever waits on the gpu. A no-op on GLES2 and on drivers without the extension. */
+class CGPUTimer {
+  public:
+    void           init(const std::string& extensions);
+
+    bool           supported();
+    // whether the current frame is being timed
+    bool           running();
+
+    void           beginFrame(CMonitor* pMonitor);
+    void           endFrame();
+
+    // ends the running stage and starts timing the given one, returns the previous stage for restoring it
+    eGPUTimerStage stage(eGPUTimerStage stage);
+
+    SGPUFrameTimes getFrameTimes(CMonitor* pMonitor);
+    SGPUTimerStats getStats();
+
+    void           destroyMonitor(CMonitor* pMonitor);
+
+  private:
+    struct SQueryFrame {
+        CMonitor*                                      pMonitor = nullptr;
+        std::vector<std::pair<eGPUTimerStage, GLuint>> queries;
+    };
+
+    void                                                                          collect();
+    GLuint                                                                        getQuery();
+    void                                                                          releaseFrame(SQueryFrame& frame);
+
+    bool                                                                          m_bSupported = false;
+    bool                                                                          m_bRunning   = false;
+    eGPUTimerStage                                                                m_eStage     = GPU_STAGE_NONE;
+
+    SQueryFrame                                                                   m_sCurrentFrame;
+    std::deque<SQueryFrame>                                                       m_dPendingFrames;
+    std::vector<GLuint>                                                           m_vFreeQueries;
+
+    std::unordered_map<CMonitor*, std::deque<std::array<float, GPU_STAGE_COUNT>>> m_mMonitorTimes;
+
+    SGPUTimerStats                                                                m_sStats;
+};
@@ -23,6 +23,8 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() {
     Debug::log(LOG, "Renderer: {}", (char*)glGetString(GL_RENDERER));
     Debug::log(LOG, "Supported extensions size: {}", std::count(m_szExtensions.begin(), m_szExtensions.end(), ' '));
 
+    m_tGPUTimer.init(m_szExtensions);
+
 #ifdef USE_TRACY_GPU
 
     loadGLProc(&glQueryCounter, "glQueryCounterEXT");
@@ -104,6 +106,8 @@ GLuint CHyprOpenGLImpl::compileShader(const GLuint& type, std::string src, bool
 }
 
 void CHyprOpenGLImpl::begin(CMonitor* pMonitor, CRegion* pDamage, bool fake) {
+    flushQuadBatch();
+
     m_RenderData.pMonitor = pMonitor;
 
     TRACY_GPU_ZONE("RenderBegin");
@@ -149,6 +153,9 @@ void CHyprOpenGLImpl::begin(CMonitor* pMonitor, CRegion* pDamage, bool fake) {
 
     m_bFakeFrame = fake;
 
+    if (!fake)
+        m_tGPUTimer.beginFrame(pMonitor);
+
     if (m_bReloadScreenShader) {
         m_bReloadScreenShader = false;
         applyScreenShader(g_pConfigManager->getString("decoration:screen_shader"));
@@ -160,8 +167,12 @@ void CHyprOpenGLImpl::end() {
 
     TRACY_GPU_ZONE("RenderEnd");
 
+    flushQuadBatch();
+
     // end the render, copy the data to the WLR framebuffer
     if (!m_bFakeFrame) {
+        setGPUTimerStage(GPU_STAGE_PRESENT);
+
         m_RenderData.damage = m_RenderData.pMonitor->lastFrameDamage;
 
         if (!m_RenderData.pMonitor->mirrors.empty())
@@ -207,6 +218,8 @@ void CHyprOpenGLImpl::end() {
         m_RenderData.useNearestNeighbor = false;
         m_bApplyFinalShader             = false;
         m_bEndFrame                     = false;
+
+        m_tGPUTimer.endFrame();
     }
 
     // reset our data
@@ -217,18 +230,29 @@ void CHyprOpenGLImpl::end() {
 }
 
 void CHyprOpenGLImpl::bindWlrOutputFb() {
+    flushQuadBatch();
     glBindFramebuffer(GL_FRAMEBUFFER, m_iWLROutputFb);
 }
 
 void CHyprOpenGLImpl::initShaders() {
-    GLuint prog                                      = createProgram(QUADVERTSRC, QUADFRAGSRC);
-    m_RenderData.pCurrentMonData->m_shQUAD.program   = prog;
-    m_RenderData.pCurrentMonData->m_shQUAD.proj      = glGetUniformLocation(prog, "proj");
-    m_RenderData.pCurrentMonData->m_shQUAD.color     = glGetUniformLocation(prog, "color");
-    m_RenderData.pCurrentMonData->m_shQUAD.posAttrib = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shQUAD.topLeft   = glGetUniformLocation(prog, "topLeft");
-    m_RenderData.pCurrentMonData->m_shQUAD.fullSize  = glGetUniformLocation(prog, "fullSize");
-    m_RenderData.pCurrentMonData->m_shQUAD.radius    = glGetUniformLocation(prog, "radius");
+    GLuint prog                                       = createProgram(QUADVERTSRC, QUADFRAGSRC);
+    m_RenderData.pCurrentMonData->m_shQUAD.program    = prog;
+    m_RenderData.pCurrentMonData->m_shQUAD.proj       = glGetUniformLocation(prog, "proj");
+    m_RenderData.pCurrentMonData->m_shQUAD.color      = glGetUniformLocation(prog, "color");
+    m_RenderData.pCurrentMonData->m_shQUAD.posAttrib  = glGetAttribLocation(prog, "pos");
+    m_RenderData.pCurrentMonData->m_shQUAD.clipAttrib = glGetAttribLocation(prog, "clip");
+    m_RenderData.pCurrentMonData->m_shQUAD.topLeft    = glGetUniformLocation(prog, "topLeft");
+    m_RenderData.pCurrentMonData->m_shQUAD.fullSize   = glGetUniformLocation(prog, "fullSize");
+    m_RenderData.pCurrentMonData->m_shQUAD.radius     = glGetUniformLocation(prog, "radius");
+
+    prog                                                     = createProgram(QUADBATCHVERTSRC, QUADBATCHFRAGSRC);
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.program      = prog;
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.proj         = glGetUniformLocation(prog, "proj");
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.posAttrib    = glGetAttribLocation(prog, "pos");
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.clipAttrib   = glGetAttribLocation(prog, "clip");
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.colorAttrib  = glGetAttribLocation(prog, "color");
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.roundAttrib  = glGetAttribLocation(prog, "roundBox");
+    m_RenderData.pCurrentMonData->m_shQUADBATCH.radiusAttrib = glGetAttribLocation(prog, "radius");
 
     prog                                                     = createProgram(TEXVERTSRC, TEXFRAGSRCRGBA);
     m_RenderData.pCurrentMonData->m_shRGBA.program           = prog;
@@ -329,7 +353,7 @@ void CHyprOpenGLImpl::initShaders() {
     m_RenderData.pCurrentMonData->m_shSHADOW.program     = prog;
     m_RenderData.pCurrentMonData->m_shSHADOW.proj        = glGetUniformLocation(prog, "proj");
     m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib   = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib   = glGetAttribLocation(prog, "texcoord");
+    m_RenderData.pCurrentMonData->m_shSHADOW.clipAttrib  = glGetAttribLocation(prog, "clip");
     m_RenderData.pCurrentMonData->m_shSHADOW.topLeft     = glGetUniformLocation(prog, "topLeft");
     m_RenderData.pCurrentMonData->m_shSHADOW.bottomRight = glGetUniformLocation(prog, "bottomRight");
     m_RenderData.pCurrentMonData->m_shSHADOW.fullSize    = glGetUniformLocation(prog, "fullSize");
@@ -343,7 +367,7 @@ void CHyprOpenGLImpl::initShaders() {
     m_RenderData.pCurrentMonData->m_shBORDER1.proj                  = glGetUniformLocation(prog, "proj");
     m_RenderData.pCurrentMonData->m_shBORDER1.thick                 = glGetUniformLocation(prog, "thick");
     m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib             = glGetAttribLocation(prog, "pos");
-    m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib             = glGetAttribLocation(prog, "texcoord");
+    m_RenderData.pCurrentMonData->m_shBORDER1.clipAttrib            = glGetAttribLocation(prog, "clip");
     m_RenderData.pCurrentMonData->m_shBORDER1.topLeft               = glGetUniformLocation(prog, "topLeft");
     m_RenderData.pCurrentMonData->m_shBORDER1.bottomRight           = glGetUniformLocation(prog, "bottomRight");
     m_RenderData.pCurrentMonData->m_shBORDER1.fullSize              = glGetUniformLocation(prog, "fullSize");
@@ -414,6 +438,8 @@ void CHyprOpenGLImpl::clear(const CColor& color) {
 }
 
 void CHyprOpenGLImpl::blend(bool enabled) {
+    flushQuadBatch();
+
     if (enabled) {
         glEnable(GL_BLEND);
         glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); // everything is premultiplied
@@ -423,9 +449,22 @@ void CHyprOpenGLImpl::blend(bool enabled) {
     m_bBlend = enabled;
 }
 
+void CHyprOpenGLImpl::stencil(bool enabled) {
+    flushQuadBatch();
+
+    if (enabled)
+        glEnable(GL_STENCIL_TEST);
+    else
+        glDisable(GL_STENCIL_TEST);
+
+    m_bStencil = enabled;
+}
+
 void CHyprOpenGLImpl::scissor(const wlr_box* pBox, bool transform) {
     RASSERT(m_RenderData.pMonitor, "Tried to scissor without begin()!");
 
+    flushQuadBatch();
+
     if (!pBox) {
         glDisable(GL_SCISSOR_TEST);
         return;
@@ -472,6 +511,8 @@ void CHyprOpenGLImpl::renderRectWithBlur(wlr_box* box, const CColor& col, int ro
     if (m_RenderData.damage.empty())
         return;
 
+    flushQuadBatch();
+
     CRegion damage{m_RenderData.damage};
     damage.intersect(box);
 
@@ -485,7 +526,7 @@ void CHyprOpenGLImpl::renderRectWithBlur(wlr_box* box, const CColor& col, int ro
     glClearStencil(0);
     glClear(GL_STENCIL_BUFFER_BIT);
 
-    glEnable(GL_STENCIL_TEST);
+    stencil(true);
 
     glStencilFunc(GL_ALWAYS, 1, -1);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
@@ -508,7 +549,7 @@ void CHyprOpenGLImpl::renderRectWithBlur(wlr_box* box, const CColor& col, int ro
 
     glClearStencil(0);
     glClear(GL_STENCIL_BUFFER_BIT);
-    glDisable(GL_STENCIL_TEST);
+    stencil(false);
     glStencilMask(-1);
     glStencilFunc(GL_ALWAYS, 1, 0xFF);
     scissor((wlr_box*)nullptr);
@@ -529,6 +570,11 @@ void CHyprOpenGLImpl::renderRectWithDamage(wlr_box* box, const CColor& col, CReg
 
     box = &newBox;
 
+    if (queueQuad(box, col, damage, round))
+        return;
+
+    flushQuadBatch();
+
     float matrix[9];
     wlr_matrix_project_box(matrix, box, wlr_output_transform_invert(!m_bEndFrame ? WL_OUTPUT_TRANSFORM_NORMAL : m_RenderData.pMonitor->transform), 0,
                            m_RenderData.pMonitor->output->transform_matrix); // TODO: write own, don't use WLR here
@@ -564,24 +610,155 @@ void CHyprOpenGLImpl::renderRectWithDamage(wlr_box* box, const CColor& col, CReg
 
     glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shQUAD.posAttrib);
 
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(*damage);
+    drawQuadWithDamage(m_RenderData.pCurrentMonData->m_shQUAD, box, damage);
 
-        if (!damageClip.empty()) {
-            for (auto& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto& RECT : damage->getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shQUAD.posAttrib);
+}
+
+bool CHyprOpenGLImpl::queueQuad(wlr_box* pBox, const CColor& col, CRegion* damage, int round) {
+#ifndef GLES2
+    // transformed boxes and stencils need the immediate path, the stencil state can change before we flush
+    if (m_bEndFrame || m_bStencil)
+        return false;
+
+    CRegion damageClip{*damage};
+    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0)
+        damageClip.intersect(m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height);
+    damageClip.intersect(pBox->x, pBox->y, pBox->width, pBox->height);
+
+    if (damageClip.empty())
+        return true;
+
+    wlr_box transformedBox;
+    wlr_box_transform(&transformedBox, pBox, wlr_output_transform_invert(m_RenderData.pMonitor->transform), m_RenderData.pMonitor->vecTransformedSize.x,
+                      m_RenderData.pMonitor->vecTransformedSize.y);
+
+    SQuadInstance instance = {
+        .color    = {col.r * col.a, col.g * col.a, col.b * col.a, col.a},
+        .roundBox = {(float)transformedBox.x, (float)transformedBox.y, (float)transformedBox.width, (float)transformedBox.height},
+        .radius   = (float)round,
+    };
+
+    for (auto& RECT : damageClip.getRects()) {
+        instance.clip[0] = RECT.x1;
+        instance.clip[1] = RECT.y1;
+        instance.clip[2] = RECT.x2 - RECT.x1;
+        instance.clip[3] = RECT.y2 - RECT.y1;
+        m_vQuadBatch.push_back(instance);
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CHyprOpenGLImpl::flushQuadBatch() {
+#ifndef GLES2
+    if (m_vQuadBatch.empty())
+        return;
+
+    TRACY_GPU_ZONE("RenderQuadBatch");
+
+    const auto PSHADER = &m_RenderData.pCurrentMonData->m_shQUADBATCH;
+
+    // batched quads are in layout px, only the output transform is left to apply
+    float glMatrix[9];
+    wlr_matrix_multiply(glMatrix, m_RenderData.projection, m_RenderData.pMonitor->output->transform_matrix);
+
+    glDisable(GL_SCISSOR_TEST);
+
+    glUseProgram(PSHADER->program);
+    glUniformMatrix3fv(PSHADER->proj, 1, GL_TRUE, glMatrix);
+
+    glVertexAttribPointer(PSHADER->posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+    glEnableVertexAttribArray(PSHADER->posAttrib);
+
+    if (!m_iQuadInstanceBuffer)
+        glGenBuffers(1, &m_iQuadInstanceBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_iQuadInstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, m_vQuadBatch.size() * sizeof(SQuadInstance), m_vQuadBatch.data(), GL_STREAM_DRAW);
+
+    const std::array<std::pair<GLint, size_t>, 4> ATTRIBS = {{
+        {PSHADER->clipAttrib, offsetof(SQuadInstance, clip)},
+        {PSHADER->colorAttrib, offsetof(SQuadInstance, color)},
+        {PSHADER->roundAttrib, offsetof(SQuadInstance, roundBox)},
+        {PSHADER->radiusAttrib, offsetof(SQuadInstance, radius)},
+    }};
+
+    for (auto& [attrib, offset] : ATTRIBS) {
+        glVertexAttribPointer(attrib, attrib == PSHADER->radiusAttrib ? 1 : 4, GL_FLOAT, GL_FALSE, sizeof(SQuadInstance), (void*)offset);
+        glVertexAttribDivisor(attrib, 1);
+        glEnableVertexAttribArray(attrib);
+    }
+
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_vQuadBatch.size());
+
+    // the rest of the renderer (and wlr) uses client side arrays without divisors
+    for (auto& [attrib, offset] : ATTRIBS) {
+        glDisableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableVertexAttribArray(PSHADER->posAttrib);
+
+    m_vQuadBatch.clear();
+#endif
+}
+
+void CHyprOpenGLImpl::drawQuadWithDamage(const CShader& shader, wlr_box* pBox, CRegion* damage, wlr_box* pHole) {
+    CRegion damageClip{*damage};
+    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0)
+        damageClip.intersect(m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height);
+
+#ifndef GLES2
+    if (!m_bEndFrame) {
+        damageClip.intersect(pBox->x, pBox->y, pBox->width, pBox->height);
+
+        if (pHole && pHole->width > 0 && pHole->height > 0)
+            damageClip.subtract(CRegion{pHole});
+
+        if (damageClip.empty())
+            return;
+
+        // one instance per damage rect, in 0-1 quad space
+        m_vQuadClips.clear();
+        for (auto& RECT : damageClip.getRects()) {
+            m_vQuadClips.insert(m_vQuadClips.end(),
+                                {(float)(RECT.x1 - pBox->x) / pBox->width, (float)(RECT.y1 - pBox->y) / pBox->height, (float)(RECT.x2 - RECT.x1) / pBox->width,
+                                 (float)(RECT.y2 - RECT.y1) / pBox->height});
         }
+
+        glDisable(GL_SCISSOR_TEST);
+
+        if (!m_iQuadInstanceBuffer)
+            glGenBuffers(1, &m_iQuadInstanceBuffer);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_iQuadInstanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, m_vQuadClips.size() * sizeof(float), m_vQuadClips.data(), GL_STREAM_DRAW);
+
+        glVertexAttribPointer(shader.clipAttrib, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribDivisor(shader.clipAttrib, 1);
+        glEnableVertexAttribArray(shader.clipAttrib);
+
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_vQuadClips.size() / 4);
+
+        glDisableVertexAttribArray(shader.clipAttrib);
+        glVertexAttribDivisor(shader.clipAttrib, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return;
     }
+#endif
 
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shQUAD.posAttrib);
+    // the whole quad, clipped by scissoring
+    glVertexAttrib4f(shader.clipAttrib, 0, 0, 1, 1);
+
+    for (auto& RECT : damageClip.getRects()) {
+        scissor(&RECT);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
 }
 
 void CHyprOpenGLImpl::renderTexture(wlr_texture* tex, wlr_box* pBox, float alpha, int round, bool allowCustomUV) {
@@ -605,6 +782,8 @@ void CHyprOpenGLImpl::renderTextureInternalWithDamage(const CTexture& tex, wlr_b
 
     TRACY_GPU_ZONE("RenderTextureInternalWithDamage");
 
+    flushQuadBatch();
+
     alpha = std::clamp(alpha, 0.f, 1.f);
 
     if (m_RenderData.damage.empty())
@@ -772,6 +951,8 @@ void CHyprOpenGLImpl::renderTexturePrimitive(const CTexture& tex, wlr_box* pBox)
 
     TRACY_GPU_ZONE("RenderTexturePrimitive");
 
+    flushQuadBatch();
+
     if (m_RenderData.damage.empty())
         return;
 
@@ -830,9 +1011,11 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
     TRACY_GPU_ZONE("RenderBlurMainFramebufferWithDamage");
 
+    const auto PREVSTAGE   = setGPUTimerStage(GPU_STAGE_BLUR);
+
     const auto BLENDBEFORE = m_bBlend;
     blend(false);
-    glDisable(GL_STENCIL_TEST);
+    stencil(false);
 
     // get transforms for the full monitor
     const auto TRANSFORM = wlr_output_transform_invert(m_RenderData.pMonitor->transform);
@@ -844,14 +1027,23 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
     wlr_matrix_multiply(glMatrix, m_RenderData.projection, matrix);
 
     // get the config settings
-    static auto* const PBLURSIZE   = &g_pConfigManager->getConfigValuePtr("decoration:blur:size")->intValue;
-    static auto* const PBLURPASSES = &g_pConfigManager->getConfigValuePtr("decoration:blur:passes")->intValue;
+    static auto* const PBLURSIZE       = &g_pConfigManager->getConfigValuePtr("decoration:blur:size")->intValue;
+    static auto* const PBLURPASSES     = &g_pConfigManager->getConfigValuePtr("decoration:blur:passes")->intValue;
+    static auto* const PBLURDOWNSAMPLE = &g_pConfigManager->getConfigValuePtr("decoration:blur:downsample")->intValue;
 
     // prep damage
     CRegion damage{*originalDamage};
     wlr_region_transform(damage.pixman(), damage.pixman(), wlr_output_transform_invert(m_RenderData.pMonitor->transform), m_RenderData.pMonitor->vecTransformedSize.x,
                          m_RenderData.pMonitor->vecTransformedSize.y);
-    wlr_region_expand(damage.pixman(), damage.pixman(), *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES));
+    wlr_region_expand(damage.pixman(), damage.pixman(), getBlurRadius());
+
+    // downsampled, the chain goes back up to half res only and the finish pass stretches that over the damage
+    const int LASTUPPASS = *PBLURDOWNSAMPLE && *PBLURPASSES > 0 ? 1 : 0;
+
+    if (!damage.empty()) {
+        m_sBlurStats.passes += *PBLURPASSES * 2 + 2 - LASTUPPASS; // color adjust, down, up, finish
+        m_sBlurStats.pixels += damage.area();
+    }
 
     // helper
     const auto    PMIRRORFB     = &m_RenderData.pCurrentMonData->mirrorFB;
@@ -972,7 +1164,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
         drawPass(&m_RenderData.pCurrentMonData->m_shBLUR1, &tempDamage); // down
     }
 
-    for (int i = *PBLURPASSES - 1; i >= 0; --i) {
+    for (int i = *PBLURPASSES - 1; i >= LASTUPPASS; --i) {
         wlr_region_scale(tempDamage.pixman(), damage.pixman(), 1.f / (1 << i)); // when upsampling we make the region twice as big
         drawPass(&m_RenderData.pCurrentMonData->m_shBLUR2, &tempDamage);        // up
     }
@@ -1005,7 +1197,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
         glUniform1i(m_RenderData.pCurrentMonData->m_shBLURFINISH.tex, 0);
 
         glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURFINISH.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-        glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
+        glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, LASTUPPASS ? halfVerts : fullVerts);
 
         glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURFINISH.posAttrib);
         glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBLURFINISH.texAttrib);
@@ -1031,9 +1223,160 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
     blend(BLENDBEFORE);
 
+    setGPUTimerStage(PREVSTAGE);
+
     return currentRenderToFB;
 }
 
+CFramebuffer* CHyprOpenGLImpl::blurWindowWithCache(float a, wlr_box* pBox, wlr_surface* pSurface, CRegion* damage) {
+#ifndef GLES2
+    static auto* const PBLURCACHE      = &g_pConfigManager->getConfigValuePtr("decoration:blur:window_cache")->intValue;
+    static auto* const PBLURSIZE       = &g_pConfigManager->getConfigValuePtr("decoration:blur:size")->intValue;
+    static auto* const PBLURPASSES     = &g_pConfigManager->getConfigValuePtr("decoration:blur:passes")->intValue;
+    static auto* const PBLURDOWNSAMPLE = &g_pConfigManager->getConfigValuePtr("decoration:blur:downsample")->intValue;
+    static auto* const PBLURNOISE      = &g_pConfigManager->getConfigValuePtr("decoration:blur:noise")->floatValue;
+    static auto* const PBLURCONTRAST   = &g_pConfigManager->getConfigValuePtr("decoration:blur:contrast")->floatValue;
+    static auto* const PBLURBRIGHTNESS = &g_pConfigManager->getConfigValuePtr("decoration:blur:brightness")->floatValue;
+
+    // only the window's own surface, drawn 1:1 into the monitor fb. Subsurfaces and popups would fight over the cache.
+    if (!*PBLURCACHE || m_bFakeFrame || !m_pCurrentWindow || m_pCurrentWindow->m_pWLSurface.wlr() != pSurface ||
+        m_RenderData.pMonitor->transform != WL_OUTPUT_TRANSFORM_NORMAL || m_RenderData.renderModif.scale != 1.f || m_RenderData.renderModif.translate != Vector2D{} ||
+        m_RenderData.mouseZoomFactor != 1.f || pBox->width < 2 || pBox->height < 2)
+        return nullptr;
+
+    auto& cache = m_mWindowBlurCaches[m_pCurrentWindow];
+
+    if (cache.pMonitor != m_RenderData.pMonitor || cache.box.x != pBox->x || cache.box.y != pBox->y || cache.box.width != pBox->width || cache.box.height != pBox->height ||
+        cache.a != a || cache.size != *PBLURSIZE || cache.passes != *PBLURPASSES || cache.downsample != *PBLURDOWNSAMPLE || cache.noise != *PBLURNOISE ||
+        cache.contrast != *PBLURCONTRAST || cache.brightness != *PBLURBRIGHTNESS) {
+        cache.valid.clear();
+
+        cache.pMonitor   = m_RenderData.pMonitor;
+        cache.box        = *pBox;
+        cache.a          = a;
+        cache.size       = *PBLURSIZE;
+        cache.passes     = *PBLURPASSES;
+        cache.downsample = *PBLURDOWNSAMPLE;
+        cache.noise      = *PBLURNOISE;
+        cache.contrast   = *PBLURCONTRAST;
+        cache.brightness = *PBLURBRIGHTNESS;
+    }
+
+    cache.fb.alloc(pBox->width, pBox->height);
+
+    CRegion toBlur{*damage};
+    toBlur.subtract(cache.valid);
+
+    const auto AREA = damage->area();
+
+    if (toBlur.empty()) {
+        m_sBlurStats.cacheHits++;
+        m_sBlurStats.cachedPixels += AREA;
+        return &cache.fb;
+    }
+
+    m_sBlurStats.cacheMisses++;
+    m_sBlurStats.cachedPixels += AREA - toBlur.area();
+
+    const auto POUTFB = blurMainFramebufferWithDamage(a, &toBlur);
+
+    // copy the fresh parts over, the cache is box-local
+    scissor((wlr_box*)nullptr);
+
+    GLint readFbBefore = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFbBefore);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, POUTFB->m_iFb);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, cache.fb.m_iFb);
+
+    for (auto& RECT : toBlur.getRects()) {
+        glBlitFramebuffer(RECT.x1, RECT.y1, RECT.x2, RECT.y2, RECT.x1 - pBox->x, RECT.y1 - pBox->y, RECT.x2 - pBox->x, RECT.y2 - pBox->y, GL_COLOR_BUFFER_BIT,
+                          GL_NEAREST);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, readFbBefore);
+
+    cache.valid.add(toBlur);
+
+    return &cache.fb;
+#else
+    return nullptr;
+#endif
+}
+
+void CHyprOpenGLImpl::invalidateBlurCaches(CMonitor* pMonitor, const CRegion& damage, wlr_surface* pSource) {
+    if (m_mWindowBlurCaches.empty() || damage.empty())
+        return;
+
+    const int                                 RADIUS = getBlurRadius();
+
+    CRegion                                   hit;
+    std::vector<std::pair<CWindow*, CRegion>> stale;
+    for (auto& [pWindow, cache] : m_mWindowBlurCaches) {
+        if (cache.pMonitor != pMonitor || cache.valid.empty())
+            continue;
+
+        // the window itself is drawn over its backdrop, not blurred into it
+        if (pSource && pWindow->m_pWLSurface.wlr() == pSource)
+            continue;
+
+        hit.set(damage).intersect(cache.box.x - RADIUS, cache.box.y - RADIUS, cache.box.width + 2 * RADIUS, cache.box.height + 2 * RADIUS);
+
+        if (hit.empty())
+            continue;
+
+        // every blurred pixel within RADIUS of the damage has seen it
+        wlr_region_expand(hit.pixman(), hit.pixman(), RADIUS);
+        hit.intersect(cache.valid);
+
+        if (hit.empty())
+            continue;
+
+        cache.valid.subtract(hit);
+        stale.emplace_back(pWindow, hit);
+    }
+
+    // what's been drawn from the stale parts is outdated on screen too, which in turn reaches the caches of blurred windows above
+    for (auto& [pWindow, region] : stale) {
+        pMonitor->addDamage(&region);
+        invalidateBlurCaches(pMonitor, region, pWindow->m_pWLSurface.wlr());
+    }
+}
+
+void CHyprOpenGLImpl::getCachedBlurRegion(CWindow* pWindow, CMonitor* pMonitor, CRegion& out) {
+    static auto* const PBLURCACHE = &g_pConfigManager->getConfigValuePtr("decoration:blur:window_cache")->intValue;
+
+    out.clear();
+
+    // same conditions as blurWindowWithCache, zoom damages everything anyways
+    if (!*PBLURCACHE || pMonitor->transform != WL_OUTPUT_TRANSFORM_NORMAL)
+        return;
+
+    const auto IT = m_mWindowBlurCaches.find(pWindow);
+    if (IT != m_mWindowBlurCaches.end() && IT->second.pMonitor == pMonitor)
+        out.set(IT->second.valid);
+}
+
+int CHyprOpenGLImpl::getBlurRadius() {
+    static auto* const PBLURSIZE   = &g_pConfigManager->getConfigValuePtr("decoration:blur:size")->intValue;
+    static auto* const PBLURPASSES = &g_pConfigManager->getConfigValuePtr("decoration:blur:passes")->intValue;
+
+    // Every pass reaches size texels of its own level, so the exact support sums up to about 2 * size * (2^passes - 1) px.
+    // The outer part of that carries next to no weight though, size * 2^passes has always been enough in practice.
+    return *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES);
+}
+
+SBlurStats CHyprOpenGLImpl::getBlurStats() {
+    return m_sBlurStats;
+}
+
+eGPUTimerStage CHyprOpenGLImpl::setGPUTimerStage(eGPUTimerStage stage) {
+    if (m_tGPUTimer.running())
+        flushQuadBatch();
+
+    return m_tGPUTimer.stage(stage);
+}
+
 void CHyprOpenGLImpl::markBlurDirtyForMonitor(CMonitor* pMonitor) {
     const auto PWORKSPACE  = g_pCompositor->getWorkspaceByID(pMonitor->activeWorkspace);
     const auto PFULLWINDOW = g_pCompositor->getFullscreenWindowOnWorkspace(pMonitor->activeWorkspace);
@@ -1231,10 +1574,15 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
     const bool    USENEWOPTIMIZE = shouldUseNewBlurOptimizations(m_pCurrentLayer, m_pCurrentWindow) && !blockBlurOptimization;
 
     CFramebuffer* POUTFB = nullptr;
+    bool          CACHED = false;
     if (!USENEWOPTIMIZE) {
         inverseOpaque.translate({pBox->x, pBox->y}).intersect(texDamage);
 
-        POUTFB = blurMainFramebufferWithDamage(a, &inverseOpaque);
+        POUTFB = blurWindowWithCache(a, pBox, pSurface, &inverseOpaque);
+        CACHED = POUTFB;
+
+        if (!CACHED)
+            POUTFB = blurMainFramebufferWithDamage(a, &inverseOpaque);
     } else {
         POUTFB = &m_RenderData.pCurrentMonData->blurFB;
     }
@@ -1247,7 +1595,7 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
     glClearStencil(0);
     glClear(GL_STENCIL_BUFFER_BIT);
 
-    glEnable(GL_STENCIL_TEST);
+    stencil(true);
 
     glStencilFunc(GL_ALWAYS, 1, -1);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
@@ -1264,12 +1612,14 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
 
     // stencil done. Render everything.
     wlr_box MONITORBOX = {0, 0, m_RenderData.pMonitor->vecTransformedSize.x, m_RenderData.pMonitor->vecTransformedSize.y};
+    // a window cache only covers the window
+    wlr_box BLURBOX = CACHED ? *pBox : MONITORBOX;
     // render our great blurred FB
     static auto* const PBLURIGNOREOPACITY = &g_pConfigManager->getConfigValuePtr("decoration:blur:ignore_opacity")->intValue;
     m_bEndFrame                           = true; // fix transformed
     const auto SAVEDRENDERMODIF           = m_RenderData.renderModif;
     m_RenderData.renderModif              = {}; // fix shit
-    renderTextureInternalWithDamage(POUTFB->m_cTex, &MONITORBOX, *PBLURIGNOREOPACITY ? blurA : a * blurA, &texDamage, 0, false, false, false);
+    renderTextureInternalWithDamage(POUTFB->m_cTex, &BLURBOX, *PBLURIGNOREOPACITY ? blurA : a * blurA, &texDamage, 0, false, false, false);
     m_bEndFrame              = false;
     m_RenderData.renderModif = SAVEDRENDERMODIF;
 
@@ -1278,7 +1628,7 @@ void CHyprOpenGLImpl::renderTextureWithBlur(const CTexture& tex, wlr_box* pBox,
     glClear(GL_STENCIL_BUFFER_BIT);
 
     // draw window
-    glDisable(GL_STENCIL_TEST);
+    stencil(false);
     renderTextureInternalWithDamage(tex, pBox, a, &texDamage, round, false, false, true, true);
 
     glStencilMask(-1);
@@ -1362,30 +1712,16 @@ void CHyprOpenGLImpl::renderBorder(wlr_box* box, const CGradientValueData& grad,
     glUniform1f(m_RenderData.pCurrentMonData->m_shBORDER1.thick, scaledBorderSize);
 
     glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
     glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib);
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib);
 
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(m_RenderData.damage);
+    // the inside is discarded by the shader anyways, don't rasterize it
+    const int INSET = scaledBorderSize + round;
+    wlr_box   hole  = {box->x + INSET, box->y + INSET, box->width - 2 * INSET, box->height - 2 * INSET};
 
-        if (!damageClip.empty()) {
-            for (auto& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto& RECT : m_RenderData.damage.getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
-    }
+    drawQuadWithDamage(m_RenderData.pCurrentMonData->m_shBORDER1, box, &m_RenderData.damage, &hole);
 
     glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.posAttrib);
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shBORDER1.texAttrib);
 
     blend(BLEND);
 }
@@ -1434,6 +1770,8 @@ void CHyprOpenGLImpl::makeRawWindowSnapshot(CWindow* pWindow, CFramebuffer* pFra
 
     g_pConfigManager->setInt("decoration:blur:enabled", BLURVAL);
 
+    flushQuadBatch();
+
 // restore original fb
 #ifndef GLES2
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iCurrentOutputFb);
@@ -1492,6 +1830,8 @@ void CHyprOpenGLImpl::makeWindowSnapshot(CWindow* pWindow) {
 
     g_pConfigManager->setInt("decoration:blur:enabled", BLURVAL);
 
+    flushQuadBatch();
+
 // restore original fb
 #ifndef GLES2
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iCurrentOutputFb);
@@ -1547,6 +1887,8 @@ void CHyprOpenGLImpl::makeLayerSnapshot(SLayerSurface* pLayer) {
     // TODO: WARN:
     // revise if any stencil-requiring rendering is done to the layers.
 
+    flushQuadBatch();
+
 // restore original fb
 #ifndef GLES2
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_iCurrentOutputFb);
@@ -1661,6 +2003,8 @@ void CHyprOpenGLImpl::renderRoundedShadow(wlr_box* box, int round, int range, fl
     float glMatrix[9];
     wlr_matrix_multiply(glMatrix, m_RenderData.projection, matrix);
 
+    flushQuadBatch();
+
     glEnable(GL_BLEND);
 
     glUseProgram(m_RenderData.pCurrentMonData->m_shSHADOW.program);
@@ -1686,30 +2030,12 @@ void CHyprOpenGLImpl::renderRoundedShadow(wlr_box* box, int round, int range, fl
     glUniform1f(m_RenderData.pCurrentMonData->m_shSHADOW.shadowPower, SHADOWPOWER);
 
     glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
-    glVertexAttribPointer(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib, 2, GL_FLOAT, GL_FALSE, 0, fullVerts);
 
     glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib);
-    glEnableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib);
-
-    if (m_RenderData.clipBox.width != 0 && m_RenderData.clipBox.height != 0) {
-        CRegion damageClip{m_RenderData.clipBox.x, m_RenderData.clipBox.y, m_RenderData.clipBox.width, m_RenderData.clipBox.height};
-        damageClip.intersect(m_RenderData.damage);
 
-        if (!damageClip.empty()) {
-            for (auto& RECT : damageClip.getRects()) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            }
-        }
-    } else {
-        for (auto& RECT : m_RenderData.damage.getRects()) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        }
-    }
+    drawQuadWithDamage(m_RenderData.pCurrentMonData->m_shSHADOW, box, &m_RenderData.damage);
 
     glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.posAttrib);
-    glDisableVertexAttribArray(m_RenderData.pCurrentMonData->m_shSHADOW.texAttrib);
 }
 
 void CHyprOpenGLImpl::saveBufferForMirror() {
@@ -1890,6 +2216,8 @@ void CHyprOpenGLImpl::destroyMonitorResources(CMonitor* pMonitor) {
     g_pHyprOpenGL->m_mMonitorBGTextures[pMonitor].destroyTexture();
     g_pHyprOpenGL->m_mMonitorRenderResources.erase(pMonitor);
     g_pHyprOpenGL->m_mMonitorBGTextures.erase(pMonitor);
+    std::erase_if(g_pHyprOpenGL->m_mWindowBlurCaches, [&](const auto& other) { return other.second.pMonitor == pMonitor; });
+    g_pHyprOpenGL->m_tGPUTimer.destroyMonitor(pMonitor);
 
     Debug::log(LOG, "Monitor {} -> destroyed all render data", pMonitor->szName);
 
@@ -1901,10 +2229,12 @@ void CHyprOpenGLImpl::saveMatrix() {
 }
 
 void CHyprOpenGLImpl::setMatrixScaleTranslate(const Vector2D& translate, const float& scale) {
+    flushQuadBatch();
     wlr_matrix_scale(m_RenderData.projection, scale, scale);
     wlr_matrix_translate(m_RenderData.projection, translate.x, translate.y);
 }
 
 void CHyprOpenGLImpl::restoreMatrix() {
+    flushQuadBatch();
     memcpy(m_RenderData.projection, m_RenderData.savedProjection, 9 * sizeof(float));
 }
@@ -13,6 +13,8 @@
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "Framebuffer.hpp"
+#include "GPUTimer.hpp"
+#include "PixelReadback.hpp"
 
 #include "../debug/TracyDefines.hpp"
 
@@ -24,6 +26,12 @@ inline const float fullVerts[] = {
     1, 1, // bottom right
     0, 1, // bottom left
 };
+inline const float halfVerts[] = {
+    0.5, 0,   // top right
+    0, 0,     // top left
+    0.5, 0.5, // bottom right
+    0, 0.5,   // bottom left
+};
 inline const float fanVertsFull[] = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f};
 
 enum eDiscardMode
@@ -37,6 +45,39 @@ struct SRenderModifData {
     float    scale     = 1.f;
 };
 
+// one rect of a batched renderRect draw
+struct SQuadInstance {
+    float clip[4];     // the damaged part of the box, layout px
+    float color[4];    // premultiplied
+    float roundBox[4]; // transformed topLeft, fullSize
+    float radius;
+};
+
+struct SBlurStats {
+    uint64_t passes       = 0; // draw calls over the monitor blur fbs
+    uint64_t pixels       = 0; // pixels covered by the (expanded) blur damage
+    uint64_t cacheHits    = 0;
+    uint64_t cacheMisses  = 0;
+    uint64_t cachedPixels = 0; // backdrop pixels served from a window cache instead of being blurred
+};
+
+// a window's blurred backdrop, kept across frames until damage under it invalidates it
+struct SWindowBlurCache {
+    CFramebuffer fb;
+    CRegion      valid; // monitor px
+
+    // what the cached contents were blurred with
+    CMonitor* pMonitor   = nullptr;
+    wlr_box   box        = {};
+    float     a          = 1.f;
+    int64_t   size       = 0;
+    int64_t   passes     = 0;
+    int64_t   downsample = 0;
+    float     noise      = 0.f;
+    float     contrast   = 0.f;
+    float     brightness = 0.f;
+};
+
 struct SMonitorRenderData {
     CFramebuffer primaryFB;
     CFramebuffer mirrorFB;     // these are used for some effects,
@@ -55,6 +96,7 @@ struct SMonitorRenderData {
     // Shaders
     bool    m_bShadersInitialized = false;
     CShader m_shQUAD;
+    CShader m_shQUADBATCH;
     CShader m_shRGBA;
     CShader m_shPASSTHRURGBA;
     CShader m_shRGBX;
@@ -116,6 +158,11 @@ class CHyprOpenGLImpl {
     void               restoreMatrix();
 
     void               blend(bool enabled);
+    // GL_STENCIL_TEST, tracked so queueQuad doesn't have to ask the driver
+    void               stencil(bool enabled);
+
+    // draws the queued renderRect calls. Anything touching gl state outside of this class has to call it first.
+    void               flushQuadBatch();
 
     void               makeWindowSnapshot(CWindow*);
     void               makeRawWindowSnapshot(CWindow*, CFramebuffer*);
@@ -142,6 +189,21 @@ class CHyprOpenGLImpl {
 
     void               applyScreenShader(const std::string& path);
 
+    // drops the cached backdrop in damage (monitor px) from every window blur cache it can reach and damages what was drawn from it.
+    // pSource's own window is skipped.
+    void               invalidateBlurCaches(CMonitor*, const CRegion& damage, wlr_surface* pSource = nullptr);
+
+    // how far blurring reaches out of the damage, monitor px
+    int                getBlurRadius();
+
+    // what pWindow's blur cache can serve without blurring on pMonitor, monitor px
+    void               getCachedBlurRegion(CWindow*, CMonitor*, CRegion& out);
+
+    SBlurStats         getBlurStats();
+
+    // switches the gpu timer to stage, returns the previous one. While timing, queued quads are flushed first so they are timed with the stage that queued them.
+    eGPUTimerStage     setGPUTimerStage(eGPUTimerStage stage);
+
     SCurrentRenderData m_RenderData;
 
     GLint              m_iCurrentOutputFb = 0;
@@ -152,7 +214,11 @@ class CHyprOpenGLImpl {
     CWindow*           m_pCurrentWindow = nullptr; // hack to get the current rendered window
     SLayerSurface*     m_pCurrentLayer  = nullptr; // hack to get the current rendered layer
 
+    CGPUTimer          m_tGPUTimer;
+    CPixelReadback     m_sPixelReadback;
+
     std::unordered_map<CWindow*, CFramebuffer>        m_mWindowFramebuffers;
+    std::unordered_map<CWindow*, SWindowBlurCache>    m_mWindowBlurCaches;
     std::unordered_map<SLayerSurface*, CFramebuffer>  m_mLayerFramebuffers;
     std::unordered_map<CMonitor*, SMonitorRenderData> m_mMonitorRenderResources;
     std::unordered_map<CMonitor*, CTexture>           m_mMonitorBGTextures;
@@ -168,6 +234,7 @@ class CHyprOpenGLImpl {
     bool              m_bEndFrame         = false;
     bool              m_bApplyFinalShader = false;
     bool              m_bBlend            = false;
+    bool              m_bStencil          = false;
 
     CShader           m_sFinalScreenShader;
     CTimer            m_tGlobalTimer;
@@ -179,10 +246,14 @@ class CHyprOpenGLImpl {
 
     // returns the out FB, can be either Mirror or MirrorSwap
     CFramebuffer* blurMainFramebufferWithDamage(float a, CRegion* damage);
+    // returns the current window's blur cache with damage filled in, or nullptr if it can't be cached
+    CFramebuffer* blurWindowWithCache(float a, wlr_box* pBox, wlr_surface* pSurface, CRegion* damage);
 
     void          renderTextureInternalWithDamage(const CTexture&, wlr_box* pBox, float a, CRegion* damage, int round = 0, bool discardOpaque = false, bool noAA = false,
                                                   bool allowCustomUV = false, bool allowDim = false);
     void          renderTexturePrimitive(const CTexture& tex, wlr_box* pBox);
+    void          drawQuadWithDamage(const CShader& shader, wlr_box* pBox, CRegion* damage, wlr_box* pHole = nullptr);
+    bool          queueQuad(wlr_box* pBox, const CColor& col, CRegion* damage, int round);
     void          renderSplash(cairo_t* const, cairo_surface_t* const, double);
 
     void          preBlurForCurrentMonitor();
@@ -190,6 +261,13 @@ class CHyprOpenGLImpl {
     bool          shouldUseNewBlurOptimizations(SLayerSurface* pLayer, CWindow* pWindow);
 
     friend class CHyprRenderer;
+
+    // instance data for quad draws
+    std::vector<SQuadInstance> m_vQuadBatch;
+    std::vector<float>         m_vQuadClips;
+    GLuint                     m_iQuadInstanceBuffer = 0;
+
+    SBlurStats                 m_sBlurStats;
 };
 
 inline std::unique_ptr<CHyprOpenGLImpl> g_pHyprOpenGL;
@@ -0,0 +1,333 @@
+#include "PixelReadback.hpp"
+#include "../Compositor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+static int handlePollTimer(void* data) {
+    ((CPixelReadback*)data)->pollFences();
+
+    return 0;
+}
+
+static int handleWake(int fd, uint32_t mask, void* data) {
+    char buf[64];
+    while (read(fd, buf, sizeof(buf)) > 0) {
+        ;
+    }
+
+    ((CPixelReadback*)data)->finishJobs();
+
+    return 0;
+}
+
+static void handleBufferDestroy(wl_listener* listener, void* data) {
+    SReadbackTarget* target = wl_container_of(listener, target, bufferDestroy);
+    g_pHyprOpenGL->m_sPixelReadback.onBufferDestroy(target);
+}
+
+bool SReadbackJob::hasTargets() const {
+    return std::ranges::any_of(targets, [](const auto& other) { return other.dest.pBuffer; });
+}
+
+CPixelReadback::~CPixelReadback() {
+    if (!m_bInitialized)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lg(m_mJobsMutex);
+        m_bExitThread = true;
+    }
+    m_cvJobs.notify_all();
+
+    if (m_tThread.joinable())
+        m_tThread.join();
+}
+
+bool CPixelReadback::init() {
+    if (m_bInitialized || m_bFailed)
+        return m_bInitialized;
+
+    if (pipe2(m_iWakeFDs, O_CLOEXEC | O_NONBLOCK) < 0) {
+        Debug::log(ERR, "[readback] Couldn't create the wake pipe, shm copies will be synchronous");
+        m_bFailed = true;
+        return false;
+    }
+
+    m_pWakeSource = wl_event_loop_add_fd(g_pCompositor->m_sWLEventLoop, m_iWakeFDs[0], WL_EVENT_READABLE, handleWake, this);
+    m_pPollTimer  = wl_event_loop_add_timer(g_pCompositor->m_sWLEventLoop, handlePollTimer, this);
+
+    m_tThread = std::thread([this]() { copyThread(); });
+
+    m_bInitialized = true;
+    return true;
+}
+
+bool CPixelReadback::readPixels(const std::vector<SReadbackDestination>& destinations, const wlr_box& box, const CRegion& damage, GLenum glFormat, GLenum glType,
+                                int bytesPerPixel) {
+#ifdef GLES2
+    return false;
+#else
+    if (destinations.empty() || box.width <= 0 || box.height <= 0)
+        return false;
+
+    for (auto& d : destinations) {
+        const auto PSHMBUFFER = wl_shm_buffer_get(d.pBuffer);
+        if (!PSHMBUFFER)
+            return false;
+
+        if (wl_shm_buffer_get_width(PSHMBUFFER) < box.width || wl_shm_buffer_get_height(PSHMBUFFER) < box.height ||
+            wl_shm_buffer_get_stride(PSHMBUFFER) < box.width * bytesPerPixel)
+            return false;
+    }
+
+    const auto SLOT = std::find_if(m_aPackBuffers.begin(), m_aPackBuffers.end(), [](const auto& other) { return !other.busy; });
+    if (SLOT == m_aPackBuffers.end() || !init())
+        return false;
+
+    CRegion clipped{damage};
+    clipped.intersect(0, 0, box.width, box.height);
+
+    const auto JOB     = m_lJobs.emplace_back(std::make_unique<SReadbackJob>()).get();
+    JOB->slot          = SLOT - m_aPackBuffers.begin();
+    JOB->bytesPerPixel = bytesPerPixel;
+
+    for (auto& r : clipped.getRects()) {
+        JOB->rects.emplace_back(SReadbackRect{r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1, JOB->size});
+        JOB->size += (size_t)(r.x2 - r.x1) * (r.y2 - r.y1) * bytesPerPixel;
+    }
+
+    if (JOB->size > 0) {
+        if (SLOT->pbo == 0)
+            glGenBuffers(1, &SLOT->pbo);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, SLOT->pbo);
+
+        if (SLOT->size < JOB->size) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, JOB->size, nullptr, GL_STREAM_READ);
+            SLOT->size = JOB->size;
+        }
+
+        // rows are tightly packed in the pack buffer, the copy thread applies the client's stride
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        for (auto& r : JOB->rects) {
+            glReadPixels(box.x + r.x, box.y + r.y, r.width, r.height, glFormat, glType, (void*)r.offset);
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    JOB->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    SLOT->busy = true;
+
+    for (auto& d : destinations) {
+        const auto PTARGET  = &JOB->targets.emplace_back();
+        PTARGET->dest       = d;
+        PTARGET->pJob       = JOB;
+        PTARGET->pShmBuffer = wl_shm_buffer_get(d.pBuffer);
+        PTARGET->pShmPool   = wl_shm_buffer_ref_pool(PTARGET->pShmBuffer);
+        PTARGET->pData      = (uint8_t*)wl_shm_buffer_get_data(PTARGET->pShmBuffer);
+        PTARGET->stride     = wl_shm_buffer_get_stride(PTARGET->pShmBuffer);
+
+        wl_list_init(&PTARGET->bufferDestroy.link);
+        PTARGET->bufferDestroy.notify = handleBufferDestroy;
+        wl_resource_add_destroy_listener(d.pBuffer, &PTARGET->bufferDestroy);
+    }
+
+    // make sure the fence actually gets submitted, otherwise it may never signal
+    glFlush();
+
+    wl_event_source_timer_update(m_pPollTimer, 1);
+
+    return true;
+#endif
+}
+
+void CPixelReadback::pollFences() {
+#ifndef GLES2
+    if (eglGetCurrentContext() != wlr_egl_get_context(g_pCompositor->m_sWLREGL))
+        eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, wlr_egl_get_context(g_pCompositor->m_sWLREGL));
+
+    bool                        stillFenced = false;
+    bool                        queued      = false;
+
+    std::lock_guard<std::mutex> lg(m_mJobsMutex);
+
+    for (auto& job : m_lJobs) {
+        if (job->state != READBACK_FENCED)
+            continue;
+
+        const auto STATUS = glClientWaitSync(job->fence, 0, 0);
+        if (STATUS == GL_TIMEOUT_EXPIRED) {
+            stillFenced = true;
+            continue;
+        }
+
+        glDeleteSync(job->fence);
+        job->fence = nullptr;
+
+        // nothing was damaged, there is nothing to copy either
+        if (STATUS != GL_WAIT_FAILED && job->hasTargets() && job->size == 0) {
+            job->state   = READBACK_DONE;
+            job->success = true;
+            wakeMainThread();
+            continue;
+        }
+
+        if (STATUS != GL_WAIT_FAILED && job->hasTargets()) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, m_aPackBuffers[job->slot].pbo);
+            job->pMapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, job->size, GL_MAP_READ_BIT);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+
+        if (!job->pMapped) {
+            job->state = READBACK_DONE;
+            wakeMainThread();
+            continue;
+        }
+
+        job->state = READBACK_QUEUED;
+        m_dCopyQueue.push_back(job.get());
+        queued = true;
+    }
+
+    if (queued)
+        m_cvJobs.notify_all();
+
+    if (stillFenced)
+        wl_event_source_timer_update(m_pPollTimer, 1);
+#endif
+}
+
+void CPixelReadback::copyThread() {
+    while (1337) {
+        SReadbackJob* job = nullptr;
+
+        {
+            std::unique_lock lk(m_mJobsMutex);
+            m_cvJobs.wait(lk, [this] { return m_bExitThread || !m_dCopyQueue.empty(); });
+
+            if (m_bExitThread)
+                break;
+
+            job = m_dCopyQueue.front();
+            m_dCopyQueue.pop_front();
+            job->state = READBACK_COPYING;
+        }
+
+        // targets can't go away while COPYING, see onBufferDestroy
+        for (auto& t : job->targets) {
+            if (!t.dest.pBuffer)
+                continue;
+
+            // the client can truncate the pool under us, begin_access turns the SIGBUS into zero pages for this thread
+            wl_shm_buffer_begin_access(t.pShmBuffer);
+
+            for (auto& r : job->rects) {
+                const size_t ROWBYTES = (size_t)r.width * job->bytesPerPixel;
+
+                for (int y = 0; y < r.height; ++y) {
+                    memcpy(t.pData + (size_t)(r.y + y) * t.stride + (size_t)r.x * job->bytesPerPixel, (uint8_t*)job->pMapped + r.offset + y * ROWBYTES, ROWBYTES);
+                }
+            }
+
+            wl_shm_buffer_end_access(t.pShmBuffer);
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(m_mJobsMutex);
+            job->state   = READBACK_DONE;
+            job->success = true;
+        }
+
+        m_cvJobs.notify_all();
+        wakeMainThread();
+    }
+}
+
+void CPixelReadback::wakeMainThread() {
+    const char BYTE = 0;
+    write(m_iWakeFDs[1], &BYTE, 1);
+}
+
+void CPixelReadback::finishJobs() {
+#ifndef GLES2
+    std::vector<std::unique_ptr<SReadbackJob>> done;
+
+    {
+        std::lock_guard<std::mutex> lg(m_mJobsMutex);
+
+        for (auto it = m_lJobs.begin(); it != m_lJobs.end();) {
+            if ((*it)->state != READBACK_DONE) {
+                it++;
+                continue;
+            }
+
+            done.emplace_back(std::move(*it));
+            it = m_lJobs.erase(it);
+        }
+    }
+
+    if (done.empty())
+        return;
+
+    if (eglGetCurrentContext() != wlr_egl_get_context(g_pCompositor->m_sWLREGL))
+        eglMakeCurrent(wlr_egl_get_display(g_pCompositor->m_sWLREGL), EGL_NO_SURFACE, EGL_NO_SURFACE, wlr_egl_get_context(g_pCompositor->m_sWLREGL));
+
+    for (auto& job : done) {
+        if (job->pMapped) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, m_aPackBuffers[job->slot].pbo);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+
+        if (job->fence)
+            glDeleteSync(job->fence);
+
+        m_aPackBuffers[job->slot].busy = false;
+
+        for (auto& t : job->targets) {
+            wl_shm_pool_unref(t.pShmPool);
+
+            wl_list_remove(&t.bufferDestroy.link);
+
+            if (t.dest.onDone)
+                t.dest.onDone(job->success && t.dest.pBuffer);
+        }
+    }
+#endif
+}
+
+void CPixelReadback::cancel(void* pOwner) {
+    for (auto& job : m_lJobs) {
+        for (auto& t : job->targets) {
+            if (t.dest.pOwner == pOwner)
+                t.dest.onDone = nullptr;
+        }
+    }
+}
+
+void CPixelReadback::onBufferDestroy(SReadbackTarget* target) {
+    const auto       JOB = target->pJob;
+
+    std::unique_lock lk(m_mJobsMutex);
+
+    // the shm buffer goes away with the resource, a copy into it has to finish first
+    m_cvJobs.wait(lk, [JOB] { return JOB->state != READBACK_COPYING; });
+
+    target->dest.pBuffer = nullptr;
+
+    wl_list_remove(&target->bufferDestroy.link);
+    wl_list_init(&target->bufferDestroy.link);
+
+    // with nobody left to copy to, the job is done
+    if (JOB->state == READBACK_QUEUED && !JOB->hasTargets()) {
+        std::erase(m_dCopyQueue, JOB);
+        JOB->state = READBACK_DONE;
+        wakeMainThread();
+    }
+}
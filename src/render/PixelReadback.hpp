@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Region.hpp"
+#include <array>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+enum eReadbackState
+{
+    READBACK_FENCED = 0, // waiting on the gpu
+    READBACK_QUEUED,     // mapped, waiting for the copy thread
+    READBACK_COPYING,
+    READBACK_DONE
+};
+
+struct SReadbackRect {
+    int    x      = 0; // box-local
+    int    y      = 0;
+    int    width  = 0;
+    int    height = 0;
+    size_t offset = 0; // into the pack buffer, rows are tightly packed
+};
+
+// a shm buffer the pixels of a read get copied into
+struct SReadbackDestination {
+    void*                     pOwner  = nullptr;
+    wl_resource*              pBuffer = nullptr;
+    std::function<void(bool)> onDone;
+};
+
+struct SReadbackJob;
+
+struct SReadbackTarget {
+    SReadbackDestination dest; // dest.pBuffer is nulled when the client destroys it
+    SReadbackJob*        pJob       = nullptr;
+    wl_shm_buffer*       pShmBuffer = nullptr;
+    wl_shm_pool*         pShmPool   = nullptr; // ref'd, so a pool resize can't move the pages under the copy
+    uint8_t*             pData      = nullptr;
+    int32_t              stride     = 0;
+    wl_listener          bufferDestroy;
+};
+
+struct SReadbackJob {
+    size_t                     slot  = 0;
+    GLsync                     fence = nullptr;
+
+    std::vector<SReadbackRect> rects;
+    int                        bytesPerPixel = 0;
+    size_t                     size          = 0;
+    void*                      pMapped       = nullptr;
+
+    std::list<SReadbackTarget> targets;
+
+    eReadbackState             state   = READBACK_FENCED;
+    bool                       success = false;
+
+    bool                       hasTargets() const;
+};
+
+/*  Asynchronous glReadPixels into client shm buffers.
+    Pixels go into a ring of pixel pack buffers behind a fence. Once the fence signals, the buffer is mapped and memcpy'd
+    into the shm pages on a separate thread, and the owners are called back on the main thread. GLES3 only.
+    One read can feed any number of buffers, so clients capturing the same thing share it. */
+class CPixelReadback {
+  public:
+    ~CPixelReadback();
+
+    /*  Reads damage (box-local) of box out of the bound read framebuffer into the same spot of every destination's shm buffer,
+        each onDone(success) runs on the main thread once the pixels landed.
+        Returns false when nothing was queued (GLES2, not all shm buffers, all pack buffers in flight), the caller has to read synchronously then. */
+    bool readPixels(const std::vector<SReadbackDestination>& destinations, const wlr_box& box, const CRegion& damage, GLenum glFormat, GLenum glType, int bytesPerPixel);
+
+    // pOwner's reads will finish without calling back
+    void cancel(void* pOwner);
+
+    // internal
+    void pollFences();
+    void finishJobs();
+    void onBufferDestroy(SReadbackTarget* target);
+
+  private:
+    struct SPackBuffer {
+        GLuint pbo  = 0;
+        size_t size = 0;
+        bool   busy = false;
+    };
+
+    bool                                     init();
+    void                                     copyThread();
+    void                                     wakeMainThread();
+
+    bool                                     m_bInitialized = false;
+    bool                                     m_bFailed      = false;
+
+    std::array<SPackBuffer, 4>               m_aPackBuffers;
+    std::list<std::unique_ptr<SReadbackJob>> m_lJobs;
+
+    wl_event_source*                         m_pPollTimer  = nullptr;
+    wl_event_source*                         m_pWakeSource = nullptr;
+    int                                      m_iWakeFDs[2] = {-1, -1};
+
+    std::thread                              m_tThread;
+    std::mutex                               m_mJobsMutex;
+    std::condition_variable                  m_cvJobs;
+    std::deque<SReadbackJob*>                m_dCopyQueue;
+    bool                                     m_bExitThread = false;
+};
@@ -162,7 +162,7 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(CMonitor* pMonitor, CWorksp
         if (w->m_bIsFullscreen || w->m_bIsFloating)
             continue;
 
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_ALL);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_ALL, true});
     }
 
     // and floating ones too
@@ -176,7 +176,7 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(CMonitor* pMonitor, CWorksp
         if (w->m_bIsFullscreen || !w->m_bIsFloating)
             continue;
 
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_ALL);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_ALL, true});
     }
 
     for (auto& w : g_pCompositor->m_vWindows) {
@@ -193,7 +193,7 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(CMonitor* pMonitor, CWorksp
         if (w->m_iWorkspaceID == pMonitor->activeWorkspace && !w->m_bIsFullscreen)
             continue;
 
-        renderWindow(w.get(), pMonitor, time, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL, RENDER_PASS_ALL);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_ALL, pWorkspace->m_efFullscreenMode != FULLSCREEN_FULL});
 
         pWorkspaceWindow = w.get();
     }
@@ -201,6 +201,7 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(CMonitor* pMonitor, CWorksp
     if (!pWorkspaceWindow) {
         // ?? happens sometimes...
         pWorkspace->m_bHasFullscreenWindow = false;
+        renderWindowQueue(pMonitor, time);
         return; // this will produce one blank frame. Oh well.
     }
 
@@ -209,8 +210,10 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(CMonitor* pMonitor, CWorksp
         if (w->m_iWorkspaceID != pWorkspaceWindow->m_iWorkspaceID || (!w->m_bCreatedOverFullscreen && !w->m_bPinned) || (!w->m_bIsMapped && !w->m_bFadingOut) || w->m_bIsFullscreen)
             continue;
 
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_ALL);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_ALL, true});
     }
+
+    renderWindowQueue(pMonitor, time);
 }
 
 void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, CWorkspace* pWorkspace, timespec* time) {
@@ -239,11 +242,11 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, CWorkspace* pWork
         }
 
         // render the bad boy
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_MAIN);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_MAIN, true});
     }
 
     if (lastWindow)
-        renderWindow(lastWindow, pMonitor, time, true, RENDER_PASS_MAIN);
+        m_vWindowRenderQueue.push_back({lastWindow, RENDER_PASS_MAIN, true});
 
     // Non-floating popup
     for (auto& w : g_pCompositor->m_vWindows) {
@@ -260,7 +263,7 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, CWorkspace* pWork
             continue;
 
         // render the bad boy
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_POPUP);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_POPUP, true});
     }
 
     // floating on top
@@ -278,7 +281,7 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, CWorkspace* pWork
             continue;
 
         // render the bad boy
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_ALL);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_ALL, true});
     }
 
     // pinned always above
@@ -296,8 +299,230 @@ void CHyprRenderer::renderWorkspaceWindows(CMonitor* pMonitor, CWorkspace* pWork
             continue;
 
         // render the bad boy
-        renderWindow(w.get(), pMonitor, time, true, RENDER_PASS_ALL);
+        m_vWindowRenderQueue.push_back({w.get(), RENDER_PASS_ALL, true});
+    }
+
+    renderWindowQueue(pMonitor, time);
+}
+
+static void sendFrameDoneToSurface(wlr_surface* surface, int x, int y, void* data) {
+    wlr_surface_send_frame_done(surface, (timespec*)data);
+}
+
+void CHyprRenderer::getWindowOpaqueRegion(CWindow* pWindow, CMonitor* pMonitor, CRegion& out) {
+    out.clear();
+
+    if (!pWindow->m_bIsMapped || pWindow->m_bFadingOut || pWindow->isHidden())
+        return;
+
+    const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(pWindow->m_iWorkspaceID);
+
+    if (!PWORKSPACE)
+        return;
+
+    // floating windows get clipped while their workspace slides, see renderWindow
+    if (pWindow->m_bIsFloating && !pWindow->m_bPinned && PWORKSPACE->m_vRenderOffset.vec() != Vector2D{})
+        return;
+
+    if (pWindow->m_fAlpha.fl() != 1.f || (pWindow->m_fActiveInactiveAlpha.fl() != 1.f && !pWindow->m_sAdditionalConfigData.forceOpaque) ||
+        (!pWindow->m_bPinned && PWORKSPACE->m_fAlpha.fl() != 1.f))
+        return;
+
+    const auto POS  = pWindow->m_vRealPosition.vec() + (pWindow->m_bPinned ? Vector2D{} : PWORKSPACE->m_vRenderOffset.vec());
+    const auto SIZE = pWindow->m_vRealSize.vec();
+
+    // rounded corners (and the aa'd px around them) aren't opaque
+    const int  INSET = std::ceil(pWindow->rounding()) + 1;
+    const int  X1 = std::ceil(POS.x) + INSET, Y1 = std::ceil(POS.y) + INSET;
+    const int  X2 = std::floor(POS.x + SIZE.x) - INSET, Y2 = std::floor(POS.y + SIZE.y) - INSET;
+    wlr_box    inner = {X1, Y1, X2 - X1, Y2 - Y1};
+
+    if (inner.width <= 0 || inner.height <= 0)
+        return;
+
+    if (pWindow->opaque()) {
+        out.add(inner.x, inner.y, inner.width, inner.height);
+    } else if (!pWindow->m_bIsX11 && !pWindow->m_vRealSize.isBeingAnimated()) {
+        // partially opaque, e.g. csd with a translucent shadow. Only when the surface isn't being stretched to the window.
+        wlr_box geom;
+        wlr_xdg_surface_get_geometry(pWindow->m_uSurface.xdg, &geom);
+
+        if (SIZE != Vector2D{geom.width, geom.height})
+            return;
+
+        out.set(CRegion{&pWindow->m_uSurface.xdg->surface->opaque_region});
+        out.translate(POS - Vector2D{geom.x, geom.y});
+        out.intersect(inner.x, inner.y, inner.width, inner.height);
+    }
+
+    if (out.empty())
+        return;
+
+    out.translate(-pMonitor->vecPosition);
+    out.scale(pMonitor->scale);
+}
+
+void CHyprRenderer::getBlurDamageAreas(CMonitor* pMonitor, CRegion& blurArea, CRegion& cached) {
+    static auto* const PBLURSPECIAL = &g_pConfigManager->getConfigValuePtr("decoration:blur:special")->intValue;
+
+    const int          BLURRADIUS = g_pHyprOpenGL->getBlurRadius();
+
+    blurArea.clear();
+    cached.clear();
+
+    // windows drawn away from their boxes and the special blur cover everything
+    for (auto& ws : g_pCompositor->m_vWorkspaces) {
+        if (ws->m_vRenderOffset.isBeingAnimated() || ws->m_fAlpha.isBeingAnimated() ||
+            (ws->m_bIsSpecialWorkspace && ws->m_iMonitorID == pMonitor->ID && ws->m_fAlpha.fl() > 0.f && *PBLURSPECIAL)) {
+            blurArea.add(0, 0, pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y);
+            return;
+        }
     }
+
+    // where blur footprints overlap, damage from one window's cached area can still change another one's blur
+    CRegion    covered, overlap, shared, windowCached;
+
+    const auto addBlurBox = [&](wlr_box box) {
+        box.x -= pMonitor->vecPosition.x;
+        box.y -= pMonitor->vecPosition.y;
+        scaleBox(&box, pMonitor->scale);
+
+        blurArea.add(box.x, box.y, box.width, box.height);
+
+        const CRegion FOOTPRINT{(double)box.x - BLURRADIUS, (double)box.y - BLURRADIUS, (double)box.width + 2 * BLURRADIUS, (double)box.height + 2 * BLURRADIUS};
+        overlap.add(shared.set(covered).intersect(FOOTPRINT));
+        covered.add(FOOTPRINT);
+    };
+
+    for (auto& w : g_pCompositor->m_vWindows) {
+        // fading out windows are drawn from their snapshots
+        if (!w->m_bIsMapped || w->isHidden() || w->m_sAdditionalConfigData.forceNoBlur || w->opaque())
+            continue;
+
+        const auto BB = w->getFullWindowBoundingBox();
+        if (!wlr_output_layout_intersects(g_pCompositor->m_sWLROutputLayout, pMonitor->output, &BB))
+            continue;
+
+        addBlurBox(BB);
+
+        g_pHyprOpenGL->getCachedBlurRegion(w.get(), pMonitor, windowCached);
+        cached.add(windowCached);
+    }
+
+    for (auto& lsl : pMonitor->m_aLayerSurfaceLayers) {
+        for (auto& ls : lsl) {
+            if (ls->forceBlur && !ls->fadingOut)
+                addBlurBox(ls->geometry);
+        }
+    }
+
+    cached.subtract(overlap);
+}
+
+void CHyprRenderer::renderWindowQueue(CMonitor* pMonitor, timespec* time) {
+    static auto* const PCULLING = &g_pConfigManager->getConfigValuePtr("misc:occlusion_culling")->intValue;
+    static auto* const PBLUR    = &g_pConfigManager->getConfigValuePtr("decoration:blur:enabled")->intValue;
+
+    // occluders are in monitor space, skip it when the pass is drawn transformed
+    const bool CULL = *PCULLING && !m_bRenderingSnapshot && g_pHyprOpenGL->m_RenderData.renderModif.translate == Vector2D{} &&
+        g_pHyprOpenGL->m_RenderData.renderModif.scale == 1.f && g_pHyprOpenGL->m_RenderData.mouseZoomFactor == 1.f;
+
+    bool       anyOccluder = false;
+
+    if (CULL) {
+        // front to back: what of the screen ends up covered by opaque windows drawn after each entry
+        m_vWindowOccluders.resize(m_vWindowRenderQueue.size());
+
+        const int BLURRADIUS = g_pHyprOpenGL->getBlurRadius();
+
+        CRegion   above, opaque;
+        for (int i = m_vWindowRenderQueue.size() - 1; i >= 0; --i) {
+            const auto PWINDOW = m_vWindowRenderQueue[i].pWindow;
+
+            m_vWindowOccluders[i].set(above);
+
+            // the main pass covers what's below, popups are left alone
+            if (m_vWindowRenderQueue[i].mode == RENDER_PASS_POPUP)
+                continue;
+
+            // a blurred window samples what's been drawn around it, that has to be complete even if it gets covered later
+            if (*PBLUR && !PWINDOW->m_sAdditionalConfigData.forceNoBlur && !above.empty() && !PWINDOW->opaque()) {
+                wlr_box bb = PWINDOW->getFullWindowBoundingBox();
+                bb.x -= pMonitor->vecPosition.x;
+                bb.y -= pMonitor->vecPosition.y;
+                scaleBox(&bb, pMonitor->scale);
+
+                above.subtract(CRegion{(double)bb.x - BLURRADIUS, (double)bb.y - BLURRADIUS, (double)bb.width + 2 * BLURRADIUS, (double)bb.height + 2 * BLURRADIUS});
+            }
+
+            getWindowOpaqueRegion(PWINDOW, pMonitor, opaque);
+            if (!opaque.empty()) {
+                above.add(opaque);
+                anyOccluder = true;
+            }
+        }
+    }
+
+    if (!anyOccluder) {
+        for (auto& e : m_vWindowRenderQueue) {
+            renderWindow(e.pWindow, pMonitor, time, e.decorate, e.mode);
+        }
+
+        m_vWindowRenderQueue.clear();
+        return;
+    }
+
+    CRegion preOccludedDamage{g_pHyprOpenGL->m_RenderData.damage};
+    CRegion windowDamage;
+
+    for (size_t i = 0; i < m_vWindowRenderQueue.size(); ++i) {
+        const auto& E = m_vWindowRenderQueue[i];
+
+        if (m_vWindowOccluders[i].empty()) {
+            g_pHyprOpenGL->m_RenderData.damage.set(preOccludedDamage);
+            renderWindow(E.pWindow, pMonitor, time, E.decorate, E.mode);
+            continue;
+        }
+
+        g_pHyprOpenGL->m_RenderData.damage.set(preOccludedDamage).subtract(m_vWindowOccluders[i]);
+
+        // what this window can touch: itself and its decorations. Popups and dim_around reach outside of that.
+        const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(E.pWindow->m_iWorkspaceID);
+        const bool BOUNDED    = !E.pWindow->m_bFadingOut && PWORKSPACE && PWORKSPACE->m_vRenderOffset.vec() == Vector2D{} && !E.pWindow->m_sAdditionalConfigData.dimAround &&
+            (E.mode == RENDER_PASS_MAIN || E.pWindow->m_bIsX11 || wl_list_empty(&E.pWindow->m_uSurface.xdg->popups));
+
+        if (BOUNDED) {
+            wlr_box bb = E.pWindow->getFullWindowBoundingBox();
+            bb.x -= pMonitor->vecPosition.x;
+            bb.y -= pMonitor->vecPosition.y;
+            scaleBox(&bb, pMonitor->scale);
+
+            const auto BEFORE = windowDamage.set(preOccludedDamage).intersect(bb.x, bb.y, bb.width, bb.height).area();
+            const auto AFTER  = windowDamage.set(g_pHyprOpenGL->m_RenderData.damage).intersect(bb.x, bb.y, bb.width, bb.height).area();
+
+            m_sOcclusionStats.culledPixels += BEFORE - AFTER;
+
+            if (windowDamage.empty()) {
+                m_sOcclusionStats.culledDraws++;
+
+                // not drawn, but still shown. Don't throttle the client.
+                if (!m_bBlockSurfaceFeedback && E.mode != RENDER_PASS_POPUP && E.pWindow->m_pWLSurface.wlr())
+                    wlr_surface_for_each_surface(E.pWindow->m_pWLSurface.wlr(), sendFrameDoneToSurface, time);
+
+                continue;
+            }
+        }
+
+        renderWindow(E.pWindow, pMonitor, time, E.decorate, E.mode);
+    }
+
+    g_pHyprOpenGL->m_RenderData.damage.set(preOccludedDamage);
+
+    m_vWindowRenderQueue.clear();
+}
+
+SOcclusionStats CHyprRenderer::getOcclusionStats() {
+    return m_sOcclusionStats;
 }
 
 void CHyprRenderer::renderWindow(CWindow* pWindow, CMonitor* pMonitor, timespec* time, bool decorate, eRenderPassMode mode, bool ignorePosition, bool ignoreAllGeometry) {
@@ -386,10 +611,15 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, CMonitor* pMonitor, timespec*
 
     // render window decorations first, if not fullscreen full
     if (mode == RENDER_PASS_ALL || mode == RENDER_PASS_MAIN) {
-        if (!pWindow->m_bIsFullscreen || PWORKSPACE->m_efFullscreenMode != FULLSCREEN_FULL)
+        if (!pWindow->m_bIsFullscreen || PWORKSPACE->m_efFullscreenMode != FULLSCREEN_FULL) {
+            const auto PREVSTAGE = g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_DECORATIONS);
+
             for (auto& wd : pWindow->m_dWindowDecorations)
                 wd->draw(pMonitor, renderdata.alpha * renderdata.fadeAlpha, offset);
 
+            g_pHyprOpenGL->setGPUTimerStage(PREVSTAGE);
+        }
+
         static auto* const PXWLUSENN = &g_pConfigManager->getConfigValuePtr("xwayland:use_nearest_neighbor")->intValue;
         if (pWindow->m_bIsX11 && *PXWLUSENN)
             g_pHyprOpenGL->m_RenderData.useNearestNeighbor = true;
@@ -416,12 +646,16 @@ void CHyprRenderer::renderWindow(CWindow* pWindow, CMonitor* pMonitor, timespec*
             if (pWindow->m_sAdditionalConfigData.borderSize.toUnderlying() != -1)
                 borderSize = pWindow->m_sAdditionalConfigData.borderSize.toUnderlying();
 
+            const auto PREVSTAGE = g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_DECORATIONS);
+
             g_pHyprOpenGL->renderBorder(&windowBox, grad, renderdata.rounding, borderSize, a1);
 
             if (ANIMATED) {
                 float a2 = renderdata.fadeAlpha * renderdata.alpha * (1.f - g_pHyprOpenGL->m_pCurrentWindow->m_fBorderFadeAnimationProgress.fl());
                 g_pHyprOpenGL->renderBorder(&windowBox, g_pHyprOpenGL->m_pCurrentWindow->m_cRealBorderColorPrevious, renderdata.rounding, borderSize, a2);
             }
+
+            g_pHyprOpenGL->setGPUTimerStage(PREVSTAGE);
         }
     }
 
@@ -730,6 +964,9 @@ bool CHyprRenderer::attemptDirectScanout(CMonitor* pMonitor) {
     wlr_surface_send_frame_done(PSURFACE, &now);
     wlr_presentation_surface_scanned_out_on_output(g_pCompositor->m_sWLRPresentation, PSURFACE, pMonitor->output);
 
+    // nothing we rendered ends up on screen, screencopy has to assume it all changed
+    pMonitor->lastFrameDamage = CRegion{0, 0, pMonitor->vecTransformedSize.x, pMonitor->vecTransformedSize.y};
+
     if (wlr_output_commit(pMonitor->output)) {
         if (!m_pLastScanout) {
             m_pLastScanout = PCANDIDATE;
@@ -937,18 +1174,25 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
 
         // if we use blur we need to expand the damage for proper blurring
         if (*PBLURENABLED == 1) {
-            // TODO: can this be optimized?
-            static auto* const PBLURSIZE   = &g_pConfigManager->getConfigValuePtr("decoration:blur:size")->intValue;
-            static auto* const PBLURPASSES = &g_pConfigManager->getConfigValuePtr("decoration:blur:passes")->intValue;
-            const auto         BLURRADIUS =
-                *PBLURPASSES > 10 ? pow(2, 15) : std::clamp(*PBLURSIZE, (int64_t)1, (int64_t)40) * pow(2, *PBLURPASSES); // is this 2^pass? I don't know but it works... I think.
+            const auto BLURRADIUS = g_pHyprOpenGL->getBlurRadius();
+
+            // only around what actually blurs. Damage a window's blur cache still covers didn't touch its backdrop,
+            // changes to the backdrop damage the blurred parts themselves when they drop the cache.
+            CRegion blurArea, cached;
+            getBlurDamageAreas(pMonitor, blurArea, cached);
 
-            // now, prep the damage, get the extended damage region
-            wlr_region_expand(damage.pixman(), damage.pixman(), BLURRADIUS); // expand for proper blurring
+            // blurred pixels within reach of the damage have changed as well
+            CRegion expanded{damage};
+            expanded.subtract(cached);
+            wlr_region_expand(expanded.pixman(), expanded.pixman(), BLURRADIUS);
+            damage.add(expanded.intersect(blurArea));
 
             pMonitor->lastFrameDamage = damage;
 
-            wlr_region_expand(damage.pixman(), damage.pixman(), BLURRADIUS); // expand for proper blurring 2
+            // and what gets blurred again samples around itself, which has to be up to date
+            expanded.set(damage).intersect(blurArea).subtract(cached);
+            wlr_region_expand(expanded.pixman(), expanded.pixman(), BLURRADIUS);
+            damage.add(expanded);
         } else {
             pMonitor->lastFrameDamage = damage;
         }
@@ -973,12 +1217,16 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
 
     if (!pMonitor->solitaryClient) {
         if (pMonitor->isMirror()) {
+            g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_WINDOWS);
+
             g_pHyprOpenGL->blend(false);
             g_pHyprOpenGL->renderMirrored();
             g_pHyprOpenGL->blend(true);
             EMIT_HOOK_EVENT("render", RENDER_POST_MIRROR);
             renderCursor = false;
         } else {
+            g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_CLEAR);
+
             g_pHyprOpenGL->blend(false);
             if (!canSkipBackBufferClear(pMonitor)) {
                 if (*PRENDERTEX /* inverted cfg flag */)
@@ -988,11 +1236,15 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
             }
             g_pHyprOpenGL->blend(true);
 
+            g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_WINDOWS);
+
             wlr_box renderBox = {0, 0, (int)pMonitor->vecPixelSize.x, (int)pMonitor->vecPixelSize.y};
             renderWorkspace(pMonitor, g_pCompositor->getWorkspaceByID(pMonitor->activeWorkspace), &now, renderBox);
 
             renderLockscreen(pMonitor, &now);
 
+            g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_OVERLAYS);
+
             if (pMonitor == g_pCompositor->m_pLastMonitor) {
                 g_pHyprNotificationOverlay->draw(pMonitor);
                 g_pHyprError->draw();
@@ -1016,11 +1268,17 @@ void CHyprRenderer::renderMonitor(CMonitor* pMonitor) {
             }
         }
     } else {
+        g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_WINDOWS);
         g_pHyprRenderer->renderWindow(pMonitor->solitaryClient, pMonitor, &now, false, RENDER_PASS_MAIN /* solitary = no popups */);
     }
 
     renderCursor = renderCursor && shouldRenderCursor();
 
+    // wlr draws the cursor on its own
+    g_pHyprOpenGL->flushQuadBatch();
+
+    g_pHyprOpenGL->setGPUTimerStage(GPU_STAGE_CURSOR);
+
     if (renderCursor && wlr_renderer_begin(g_pCompositor->m_sWLRRenderer, pMonitor->vecPixelSize.x, pMonitor->vecPixelSize.y)) {
         TRACY_GPU_ZONE("RenderCursor");
 
@@ -1423,6 +1681,7 @@ void CHyprRenderer::damageSurface(wlr_surface* pSurface, double x, double y, dou
         wlr_region_scale(damageBoxForEach.pixman(), damageBoxForEach.pixman(), m->scale);
         damageBoxForEach.translate({lx + m->vecPosition.x, ly + m->vecPosition.y});
 
+        g_pHyprOpenGL->invalidateBlurCaches(m.get(), damageBoxForEach, pSurface);
         m->addDamage(&damageBoxForEach);
     }
 
@@ -1441,7 +1700,7 @@ void CHyprRenderer::damageWindow(CWindow* pWindow) {
     for (auto& m : g_pCompositor->m_vMonitors) {
         wlr_box fixedDamageBox = {damageBox.x - m->vecPosition.x, damageBox.y - m->vecPosition.y, damageBox.width, damageBox.height};
         scaleBox(&fixedDamageBox, m->scale);
-        m->addDamage(&fixedDamageBox);
+        addMonitorDamage(m.get(), &fixedDamageBox);
     }
 
     for (auto& wd : pWindow->m_dWindowDecorations)
@@ -1458,6 +1717,7 @@ void CHyprRenderer::damageMonitor(CMonitor* pMonitor) {
         return;
 
     wlr_box damageBox = {0, 0, INT16_MAX, INT16_MAX};
+    g_pHyprOpenGL->invalidateBlurCaches(pMonitor, &damageBox);
     pMonitor->addDamage(&damageBox);
 
     static auto* const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
@@ -1476,7 +1736,7 @@ void CHyprRenderer::damageBox(wlr_box* pBox) {
 
         wlr_box damageBox = {pBox->x - m->vecPosition.x, pBox->y - m->vecPosition.y, pBox->width, pBox->height};
         scaleBox(&damageBox, m->scale);
-        m->addDamage(&damageBox);
+        addMonitorDamage(m.get(), &damageBox);
     }
 
     static auto* const PLOGDAMAGE = &g_pConfigManager->getConfigValuePtr("debug:log_damage")->intValue;
@@ -1496,12 +1756,68 @@ void CHyprRenderer::damageRegion(const CRegion& rg) {
     }
 }
 
+void CHyprRenderer::addMonitorDamage(CMonitor* pMonitor, wlr_box* box) {
+    g_pHyprOpenGL->invalidateBlurCaches(pMonitor, box);
+
+    if (!m_bDamageBatching) {
+        pMonitor->addDamage(box);
+        return;
+    }
+
+    if (box->width <= 0 || box->height <= 0)
+        return;
+
+    m_mDamageBatch[pMonitor].push_back({box->x, box->y, box->x + box->width, box->y + box->height});
+}
+
+void CHyprRenderer::beginDamageBatch() {
+    m_bDamageBatching = true;
+}
+
+void CHyprRenderer::endDamageBatch() {
+    if (!m_bDamageBatching)
+        return;
+
+    m_bDamageBatching = false;
+
+    bool damaged = false;
+
+    // go through m_vMonitors, not the batch, so monitors which went away in between are never touched
+    for (auto& m : g_pCompositor->m_vMonitors) {
+        const auto IT = m_mDamageBatch.find(m.get());
+
+        if (IT == m_mDamageBatch.end() || IT->second.empty())
+            continue;
+
+        // one pass over all the boxes instead of a union per box
+        CRegion rg{IT->second};
+
+        m_sDamageBatchStats.rectsIn  += IT->second.size();
+        m_sDamageBatchStats.rectsOut += pixman_region32_n_rects(rg.pixman());
+
+        m->addDamage(&rg);
+        damaged = true;
+    }
+
+    for (auto& [mon, boxes] : m_mDamageBatch) {
+        boxes.clear();
+    }
+
+    if (damaged)
+        m_sDamageBatchStats.batches++;
+}
+
+SDamageBatchStats CHyprRenderer::getDamageBatchStats() {
+    return m_sDamageBatchStats;
+}
+
 void CHyprRenderer::damageMirrorsWith(CMonitor* pMonitor, const CRegion& pRegion) {
     for (auto& mirror : pMonitor->mirrors) {
         Vector2D scale = {mirror->vecSize.x / pMonitor->vecSize.x, mirror->vecSize.y / pMonitor->vecSize.y};
 
         CRegion  rg{pRegion};
         wlr_region_scale_xy(rg.pixman(), rg.pixman(), scale.x, scale.y);
+        g_pHyprOpenGL->invalidateBlurCaches(pMonitor, rg);
         pMonitor->addDamage(&rg);
 
         g_pCompositor->scheduleFrameForMonitor(mirror);
@@ -2,6 +2,7 @@
 
 #include "../defines.hpp"
 #include <list>
+#include <unordered_map>
 #include "../helpers/Monitor.hpp"
 #include "../helpers/Workspace.hpp"
 #include "../Window.hpp"
@@ -11,6 +12,12 @@
 
 struct SMonitorRule;
 
+struct SDamageBatchStats {
+    uint64_t batches  = 0; // flushed batches which damaged anything
+    uint64_t rectsIn  = 0; // boxes damaged while batching, once per monitor
+    uint64_t rectsOut = 0; // rects submitted to the damage rings after merging
+};
+
 // TODO: add fuller damage tracking for updating only parts of a window
 enum DAMAGETRACKINGMODES
 {
@@ -27,6 +34,17 @@ enum eRenderPassMode
     RENDER_PASS_POPUP
 };
 
+struct SOcclusionStats {
+    uint64_t culledDraws  = 0; // window passes not drawn at all, being fully behind opaque windows
+    uint64_t culledPixels = 0; // damaged px of windows which were behind opaque ones
+};
+
+struct SQueuedWindowRender {
+    CWindow*        pWindow  = nullptr;
+    eRenderPassMode mode     = RENDER_PASS_ALL;
+    bool            decorate = true;
+};
+
 class CToplevelExportProtocolManager;
 class CInputManager;
 struct SSessionLockSurface;
@@ -45,6 +63,10 @@ class CHyprRenderer {
     void                            damageRegion(const CRegion&);
     void                            damageMonitor(CMonitor*);
     void                            damageMirrorsWith(CMonitor*, const CRegion&);
+    void                            beginDamageBatch();
+    void                            endDamageBatch();
+    SDamageBatchStats               getDamageBatchStats();
+    SOcclusionStats                 getOcclusionStats();
     bool                            applyMonitorRule(CMonitor*, SMonitorRule*, bool force = false);
     bool                            shouldRenderWindow(CWindow*, CMonitor*, CWorkspace*);
     bool                            shouldRenderWindow(CWindow*);
@@ -94,6 +116,9 @@ class CHyprRenderer {
     void renderIMEPopup(SIMEPopup*, CMonitor*, timespec*);
     void renderWorkspace(CMonitor* pMonitor, CWorkspace* pWorkspace, timespec* now, const wlr_box& geometry);
     void renderAllClientsForWorkspace(CMonitor* pMonitor, CWorkspace* pWorkspace, timespec* now, const Vector2D& translate = {0, 0}, const float& scale = 1.f);
+    void renderWindowQueue(CMonitor* pMonitor, timespec* now);
+    void getWindowOpaqueRegion(CWindow* pWindow, CMonitor* pMonitor, CRegion& out);
+    void getBlurDamageAreas(CMonitor* pMonitor, CRegion& blurArea, CRegion& cached);
 
     bool m_bHasARenderedCursor = true;
     bool m_bCursorHasSurface   = false;
@@ -101,6 +126,18 @@ class CHyprRenderer {
     friend class CHyprOpenGLImpl;
     friend class CToplevelExportProtocolManager;
     friend class CInputManager;
+
+    // while batching, damage is collected per monitor and submitted as one region on endDamageBatch()
+    void                                                       addMonitorDamage(CMonitor* pMonitor, wlr_box* box);
+
+    bool                                                       m_bDamageBatching = false;
+    std::unordered_map<CMonitor*, std::vector<pixman_box32_t>> m_mDamageBatch;
+    SDamageBatchStats                                          m_sDamageBatchStats;
+
+    // windows of a pass, queued bottom to top so what's under opaque windows drawn later can be culled
+    std::vector<SQueuedWindowRender> m_vWindowRenderQueue;
+    std::vector<CRegion>             m_vWindowOccluders;
+    SOcclusionStats                  m_sOcclusionStats;
 };
 
 inline std::unique_ptr<CHyprRenderer> g_pHyprRenderer;
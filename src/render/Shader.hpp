@@ -14,6 +14,10 @@ class CShader {
     GLint   alpha             = -1;
     GLint   posAttrib         = -1;
     GLint   texAttrib         = -1;
+    GLint   clipAttrib        = -1;
+    GLint   colorAttrib       = -1;
+    GLint   roundAttrib       = -1;
+    GLint   radiusAttrib      = -1;
     GLint   discardOpaque     = -1;
     GLint   discardAlpha      = -1;
     GLfloat discardAlphaValue = -1;
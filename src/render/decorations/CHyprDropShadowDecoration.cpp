@@ -121,7 +121,7 @@ void CHyprDropShadowDecoration::draw(CMonitor* pMonitor, float a, const Vector2D
     g_pHyprOpenGL->scissor((wlr_box*)nullptr);
 
     if (*PSHADOWIGNOREWINDOW) {
-        glEnable(GL_STENCIL_TEST);
+        g_pHyprOpenGL->stencil(true);
 
         glClearStencil(0);
         glClear(GL_STENCIL_BUFFER_BIT);
@@ -136,7 +136,7 @@ void CHyprDropShadowDecoration::draw(CMonitor* pMonitor, float a, const Vector2D
         if (windowBox.width < 1 || windowBox.height < 1) {
             glClearStencil(0);
             glClear(GL_STENCIL_BUFFER_BIT);
-            glDisable(GL_STENCIL_TEST);
+            g_pHyprOpenGL->stencil(false);
             return; // prevent assert failed
         }
 
@@ -153,6 +153,6 @@ void CHyprDropShadowDecoration::draw(CMonitor* pMonitor, float a, const Vector2D
         // cleanup
         glClearStencil(0);
         glClear(GL_STENCIL_BUFFER_BIT);
-        glDisable(GL_STENCIL_TEST);
+        g_pHyprOpenGL->stencil(false);
     }
 }
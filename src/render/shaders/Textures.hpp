@@ -32,18 +32,20 @@ inline static constexpr auto ROUNDED_SHADER_FUNC = [](const std::string colorVar
 )#";
 };
 
+// clip is the part of the 0-1 quad to draw, one instance per damage rect
 inline const std::string QUADVERTSRC = R"#(
 uniform mat3 proj;
 uniform vec4 color;
 attribute vec2 pos;
-attribute vec2 texcoord;
+attribute vec4 clip;
 varying vec4 v_color;
 varying vec2 v_texcoord;
 
 void main() {
-    gl_Position = vec4(proj * vec3(pos, 1.0), 1.0);
+    vec2 quadPos = clip.xy + pos * clip.zw;
+    gl_Position = vec4(proj * vec3(quadPos, 1.0), 1.0);
     v_color = color;
-    v_texcoord = texcoord;
+    v_texcoord = quadPos;
 })#";
 
 inline const std::string QUADFRAGSRC = R"#(
@@ -66,6 +68,47 @@ void main() {
     gl_FragColor = pixColor;
 })#";
 
+// batched rects, everything per instance. clip is in layout px here.
+inline const std::string QUADBATCHVERTSRC = R"#(
+uniform mat3 proj;
+attribute vec2 pos;
+attribute vec4 clip;
+attribute vec4 color;
+attribute vec4 roundBox;
+attribute float radius;
+varying vec4 v_color;
+varying vec4 v_roundBox;
+varying float v_radius;
+
+void main() {
+    gl_Position = vec4(proj * vec3(clip.xy + pos * clip.zw, 1.0), 1.0);
+    v_color = color;
+    v_roundBox = roundBox;
+    v_radius = radius;
+})#";
+
+inline const std::string QUADBATCHFRAGSRC = R"#(
+precision mediump float;
+varying vec4 v_color;
+varying highp vec4 v_roundBox;
+varying highp float v_radius;
+
+void main() {
+
+    vec4 pixColor = v_color;
+
+    highp vec2 topLeft = v_roundBox.xy;
+    highp vec2 fullSize = v_roundBox.zw;
+    highp float radius = v_radius;
+
+    if (radius > 0.0) {
+	)#" +
+    ROUNDED_SHADER_FUNC("pixColor") + R"#(
+    }
+
+    gl_FragColor = pixColor;
+})#";
+
 inline const std::string TEXVERTSRC = R"#(
 uniform mat3 proj;
 attribute vec2 pos;